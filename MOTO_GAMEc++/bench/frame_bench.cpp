@@ -0,0 +1,247 @@
+// Headless Frame Benchmark
+// Drives each GameState through the real game code (handleEvent/updateGame/renderGame
+// from game.cpp) for a fixed number of frames on SDL's software renderer and reports
+// mean/p50/p99 frame time, draw calls and heap allocations per frame, followed by
+// microbenchmarks for the update step, spawning and collision (discrete, swept and
+// pixel masks).
+// One simulation tick runs per frame, so runs are comparable between machines and builds.
+//
+// Linux:   g++ -O2 -std=c++17 -pthread -Isrc bench/frame_bench.cpp $(ls src/*.cpp | grep -v main.cpp) $(sdl2-config --cflags --libs) -lSDL2_image -lSDL2_ttf -lSDL2_mixer -o bin/frame_bench
+// Run from bin/ (assets are resolved relative to it): ./frame_bench [--frames N] [--capture <file.y4m|prefix>]
+// --capture renders through the scene target, as the game does, and records the timed
+// frames (capture.h); the readback happens outside the timed part of each frame.
+// SDL_VIDEODRIVER and SDL_AUDIODRIVER default to "dummy"; set SDL_VIDEODRIVER=offscreen to use that instead.
+
+#include <SDL.h>
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "config.h"
+#include "types.h"
+#include "globals.h"
+#include "functions.h"
+#include "assets.h"
+#include "entities.h"
+#include "sprites.h"
+#include "profiler.h"
+#include "frame_arena.h"
+#include "alloc_tracker.h"
+#include "capture.h"
+#include "resolution.h"
+
+namespace {
+
+const int WARMUP_FRAMES = 10;
+const SDL_Point NO_MOUSE = { -1, -1 }; // Keeps menu hover states stable
+
+struct Scenario {
+    const char* name;
+    GameState state;
+    void (*setup)();
+    void (*input)(int frame); // Scripted input, may be nullptr
+};
+
+void sendKey(Uint32 type, SDL_Keycode key) {
+    SDL_Event e = {};
+    e.type = type;
+    e.key.keysym.sym = key;
+    handleEvent(e, NO_MOUSE);
+}
+
+void setupNothing() {}
+void setupPlaying() { resetGameState(); }
+void setupStress() { enableStressMode(STRESS_DEFAULT_ENTITIES); resetGameState(); }
+
+// Weave up and down the road, drifting left/right, like a player dodging
+void playingInput(int frame) {
+    static const SDL_Keycode PATTERN[] = { SDLK_UP, SDLK_RIGHT, SDLK_DOWN, SDLK_LEFT };
+    const int holdFrames = 45;
+    if (frame % holdFrames == 0) {
+        int step = frame / holdFrames;
+        if (step > 0) sendKey(SDL_KEYUP, PATTERN[(step - 1) % 4]);
+        sendKey(SDL_KEYDOWN, PATTERN[step % 4]);
+    }
+}
+
+double percentile(const std::vector<double>& sorted, double p) {
+    if (sorted.empty()) return 0.0;
+    size_t index = (size_t)(p * (sorted.size() - 1) + 0.5);
+    return sorted[std::min(index, sorted.size() - 1)];
+}
+
+double elapsedMs(Uint64 start) {
+    return (double)(SDL_GetPerformanceCounter() - start) * 1000.0 / (double)SDL_GetPerformanceFrequency();
+}
+
+void runFrame(const Scenario& scenario, int frame, float simDt) {
+    beginProfilerFrame();
+    resetFrameArena();
+    if (scenario.input) scenario.input(frame);
+    storePreviousPositions();
+    updateGame(simDt);
+    if (gCurrentState != scenario.state) { gCurrentState = scenario.state; scenario.setup(); } // Lost or won: restart
+    bool scene = isFrameCaptureActive();
+    if (scene) beginSceneFrame(gRenderer);
+    renderGame(NO_MOUSE, 1.0f);
+    if (scene) endSceneFrame(gRenderer);
+    SDL_RenderPresent(gRenderer);
+    endProfilerFrame();
+}
+
+void runScenario(const Scenario& scenario, int frames, float simDt) {
+    gCurrentState = scenario.state;
+    scenario.setup();
+    for (int i = 0; i < WARMUP_FRAMES; ++i) runFrame(scenario, i, simDt);
+
+    std::vector<double> times;
+    times.reserve(frames);
+    double drawCalls = 0.0;
+    Uint64 allocationsBefore = getThreadAllocations().allocations;
+    for (int i = 0; i < frames; ++i) {
+        Uint64 start = SDL_GetPerformanceCounter();
+        runFrame(scenario, WARMUP_FRAMES + i, simDt);
+        times.push_back(elapsedMs(start));
+        captureFrame(gRenderer);
+        drawCalls += getLastFrameDrawCalls();
+    }
+    double allocations = (double)(getThreadAllocations().allocations - allocationsBefore); // times is reserved: all of it is the game's
+
+    double mean = 0.0;
+    for (double t : times) mean += t;
+    mean /= frames;
+    std::sort(times.begin(), times.end());
+    std::printf("%-18s %7d %9.3f %9.3f %9.3f %11.1f %12.2f\n", scenario.name, frames, mean, percentile(times, 0.50), percentile(times, 0.99), drawCalls / frames, allocations / frames);
+}
+
+// --- Microbenchmarks ---
+void benchUpdate(int ticks, float simDt) {
+    gCurrentState = GameState::PLAYING;
+    resetGameState();
+    Uint64 start = SDL_GetPerformanceCounter();
+    for (int i = 0; i < ticks; ++i) {
+        storePreviousPositions();
+        updateGame(simDt);
+        if (gCurrentState != GameState::PLAYING) { gCurrentState = GameState::PLAYING; resetGameState(); }
+    }
+    std::printf("%-28s %10.1f ns/tick   (%d ticks)\n", "update (PLAYING)", elapsedMs(start) * 1e6 / ticks, ticks);
+}
+
+void benchSpawning(int capacity, int rounds) {
+    EntityStore store;
+    initEntityStore(store, capacity);
+    Uint64 start = SDL_GetPerformanceCounter();
+    for (int r = 0; r < rounds; ++r) {
+        for (int i = 0; i < capacity; ++i) spawnEntity(store, (float)SCREEN_WIDTH, (float)ROAD_Y, i % 3);
+        for (int i = store.count - 1; i >= 0; --i) removeEntity(store, i);
+    }
+    std::printf("%-28s %10.2f ns/entity (spawn + remove, %d x %d)\n", "spawning", elapsedMs(start) * 1e6 / ((double)capacity * rounds), rounds, capacity);
+}
+
+void benchCollision(int entities, int rounds) {
+    EntityStore store;
+    initEntityStore(store, entities);
+    std::mt19937 rng(1234);
+    std::uniform_real_distribution<float> xDist(0.0f, (float)SCREEN_WIDTH), yDist((float)ROAD_Y, (float)(ROAD_Y + ROAD_HEIGHT - BARRIER_HEIGHT));
+    for (int i = 0; i < entities; ++i) spawnEntity(store, xDist(rng), yDist(rng), i % 3);
+
+    int hits = 0;
+    Uint64 start = SDL_GetPerformanceCounter();
+    for (int r = 0; r < rounds; ++r) {
+        hits += collideEntities(store, PLAYER_START_X + (float)(r % 40) - 20.0f, (float)PLAYER_BOUNDS_TOP, PLAYER_SQUARE_SIZE, BARRIER_WIDTH, BARRIER_HEIGHT, BARRIER_HITBOX_INSET);
+    }
+    double ms = elapsedMs(start);
+    std::printf("%-28s %10.2f ns/entity (%d entities, %.1f us/call, %d hits)\n", "collision", ms * 1e6 / ((double)entities * rounds), entities, ms * 1e3 / rounds, hits);
+
+    hits = 0;
+    float impact;
+    const float deltaX = -BARRIER_SPEED / SIM_TICK_RATE;
+    start = SDL_GetPerformanceCounter();
+    for (int r = 0; r < rounds; ++r) {
+        float playerY = (float)PLAYER_BOUNDS_TOP + (float)(r % 40);
+        PlayerSweep sweep = { (float)PLAYER_START_X, playerY, (float)PLAYER_START_X, playerY + PLAYER_VERT_SPEED / SIM_TICK_RATE, PLAYER_SQUARE_SIZE };
+        hits += sweepEntities(store, deltaX, sweep, BARRIER_WIDTH, BARRIER_HEIGHT, BARRIER_HITBOX_INSET, 1.0f, impact);
+    }
+    ms = elapsedMs(start);
+    std::printf("%-28s %10.2f ns/entity (%d entities, %.1f us/call, %d hits)\n", "collision (swept)", ms * 1e6 / ((double)entities * rounds), entities, ms * 1e3 / rounds, hits);
+
+    // As stepWorld() does with masks: sprite boxes, then the pixel test on their hits
+    const CollisionMask* playerMask = getSpriteMask(SpriteId::PLAYER_MALE);
+    const CollisionMask* barrierMasks = getSpriteMask(SpriteId::BARRIER_01);
+    if (!playerMask || !barrierMasks || !getSpriteMask(SpriteId::BARRIER_02) || !getSpriteMask(SpriteId::BARRIER_03)) {
+        std::printf("%-28s %10s (sprite masks not loaded)\n", "collision (masks)", "-");
+        return;
+    }
+    hits = 0;
+    int candidates = 0;
+    start = SDL_GetPerformanceCounter();
+    for (int r = 0; r < rounds; ++r) {
+        float playerY = (float)PLAYER_BOUNDS_TOP + (float)(r % 40);
+        PlayerSweep sweep = { (float)PLAYER_START_X, playerY, (float)PLAYER_START_X, playerY + PLAYER_VERT_SPEED / SIM_TICK_RATE, PLAYER_SQUARE_SIZE };
+        int boxHits = sweepEntities(store, deltaX, sweep, BARRIER_WIDTH, BARRIER_HEIGHT, 0, 1.0f, impact);
+        candidates += boxHits;
+        if (boxHits > 0) hits += refineSweepHits(store, deltaX, sweep, *playerMask, barrierMasks, 1.0f, impact);
+    }
+    ms = elapsedMs(start);
+    std::printf("%-28s %10.2f ns/entity (%d entities, %.1f us/call, %d of %d box hits)\n", "collision (masks)", ms * 1e6 / ((double)entities * rounds), entities, ms * 1e3 / rounds, hits, candidates);
+}
+
+} // namespace
+
+int main(int argc, char* args[]) {
+    int frames = 600;
+    std::string capturePath;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = args[i];
+        if (arg == "--frames" && i + 1 < argc) { frames = std::max(1, std::atoi(args[++i])); }
+        else if (arg == "--capture" && i + 1 < argc) { capturePath = args[++i]; }
+    }
+
+    // Headless by default; an explicit environment setting wins
+    SDL_setenv("SDL_VIDEODRIVER", "dummy", 0);
+    SDL_setenv("SDL_AUDIODRIVER", "dummy", 0);
+    SDL_SetHint(SDL_HINT_RENDER_DRIVER, "software");
+    SDL_SetHint(SDL_HINT_RENDER_VSYNC, "0");
+
+    if (!initializeSDL()) { std::cerr << "Initialization Failed. Exiting." << std::endl; return 1; }
+    if (!loadMedia()) { std::cerr << "Media Loading Failed. Exiting." << std::endl; closeSDL(); return 1; }
+    for (int g = 0; g < (int)AssetGroup::COUNT; ++g) waitForAssetGroup((AssetGroup)g, gRenderer);
+    if (hasAssetLoadingFailed()) { std::cerr << "Media Loading Failed. Exiting." << std::endl; closeSDL(); return 1; }
+    if (!capturePath.empty()) {
+        initDynamicResolution(gRenderer, 0.0, 1.0f); // Fixed full scale: only provides the scene target to read back
+        if (!startFrameCapture(capturePath, 1, 0)) { closeSDL(); return 1; } // fps 0: one slot per timed frame
+    }
+
+    const float simDt = 1.0f / gSimTickRate;
+    const Scenario scenarios[] = {
+        { "MENU", GameState::MENU, setupNothing, nullptr },
+        { "ABOUT", GameState::ABOUT, setupNothing, nullptr },
+        { "CHARACTER_SELECT", GameState::CHARACTER_SELECT, setupNothing, nullptr },
+        { "PLAYING", GameState::PLAYING, setupPlaying, playingInput },
+        { "WIN", GameState::WIN, setupNothing, nullptr },
+        { "LOSE", GameState::LOSE, setupNothing, nullptr },
+        { "PLAYING (stress)", GameState::PLAYING, setupStress, playingInput }, // Last: stress mode stays on
+    };
+
+    std::printf("\n%-18s %7s %9s %9s %9s %11s %12s\n", "state", "frames", "mean ms", "p50 ms", "p99 ms", "draws/frame", "allocs/frame");
+    for (const Scenario& scenario : scenarios) runScenario(scenario, frames, simDt);
+
+    std::printf("\n");
+    gStressMode = false;
+    gMaxBarriers = MAX_BARRIERS;
+    gMaxCoins = MAX_COINS;
+    gBarrierSpawnInterval = BARRIER_SPAWN_INTERVAL;
+    gCoinSpawnInterval = COIN_SPAWN_INTERVAL;
+    benchUpdate(200000, simDt);
+    benchSpawning(STRESS_DEFAULT_ENTITIES, 200);
+    benchCollision(STRESS_DEFAULT_ENTITIES, 20000);
+
+    reportFrameCapture();
+    gCurrentState = GameState::EXIT;
+    closeSDL();
+    return 0;
+}
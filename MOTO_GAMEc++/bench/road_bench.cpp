@@ -0,0 +1,79 @@
+// Road Renderer Benchmark
+// Compares the original per-scanline road (ROAD_HEIGHT copies + powf per frame)
+// against the baked road from road.cpp on SDL's software renderer, drawing into
+// an offscreen surface so no window or GPU is needed.
+//
+// Linux:   g++ -O2 -std=c++17 -Isrc bench/road_bench.cpp src/road.cpp $(sdl2-config --cflags --libs) -lSDL2_image -o bin/road_bench
+// Run from bin/ (assets are resolved relative to it): ./road_bench [frames]
+
+#include <SDL.h>
+#include <SDL_image.h>
+#include <iostream>
+#include <string>
+#include <cstdlib>
+
+#include "config.h"
+#include "road.h"
+
+namespace {
+
+double runFrames(SDL_Renderer* renderer, int frames, void (*drawFrame)(SDL_Renderer*)) {
+    Uint64 start = SDL_GetPerformanceCounter();
+    for (int i = 0; i < frames; ++i) {
+        SDL_SetRenderDrawColor(renderer, 0, 0, 0, 255);
+        SDL_RenderClear(renderer);
+        drawFrame(renderer);
+        SDL_RenderFlush(renderer);
+    }
+    Uint64 end = SDL_GetPerformanceCounter();
+    return (double)(end - start) * 1000.0 / (double)SDL_GetPerformanceFrequency() / frames;
+}
+
+SDL_Texture* gBenchRoadTexture = nullptr;
+
+void drawScanlinePath(SDL_Renderer* renderer) { renderRoadScanlines(gBenchRoadTexture, renderer); }
+void drawBakedPath(SDL_Renderer* renderer) { renderRoad(renderer); }
+
+} // namespace
+
+int main(int argc, char* args[]) {
+    int frames = (argc > 1) ? std::atoi(args[1]) : 500;
+    if (frames <= 0) frames = 500;
+
+    if (SDL_Init(0) < 0) { std::cerr << "FATAL ERROR: SDL could not initialize! SDL_Error: " << SDL_GetError() << std::endl; return 1; }
+    IMG_Init(IMG_INIT_JPG | IMG_INIT_PNG);
+
+    SDL_Surface* frameSurface = SDL_CreateRGBSurfaceWithFormat(0, SCREEN_WIDTH, SCREEN_HEIGHT, 32, SDL_PIXELFORMAT_ARGB8888);
+    SDL_Renderer* renderer = frameSurface ? SDL_CreateSoftwareRenderer(frameSurface) : nullptr;
+    if (!renderer) { std::cerr << "FATAL ERROR: Software renderer could not be created! SDL Error: " << SDL_GetError() << std::endl; return 1; }
+
+    SDL_Surface* roadSurface = IMG_Load("../assets/images/background_near.jpg");
+    if (!roadSurface) {
+        std::cerr << "WARNING: Road image not found, using a generated 1024x512 texture." << std::endl;
+        roadSurface = SDL_CreateRGBSurfaceWithFormat(0, 1024, 512, 32, SDL_PIXELFORMAT_ARGB8888);
+        SDL_FillRect(roadSurface, nullptr, 0xFF505050);
+    }
+    gBenchRoadTexture = SDL_CreateTextureFromSurface(renderer, roadSurface);
+    SDL_FreeSurface(roadSurface);
+    if (!gBenchRoadTexture || !initRoadRenderer(gBenchRoadTexture, renderer)) { std::cerr << "FATAL ERROR: Road setup failed! SDL Error: " << SDL_GetError() << std::endl; return 1; }
+
+    // Warm up both paths once so texture uploads are not measured
+    runFrames(renderer, 10, drawScanlinePath);
+    runFrames(renderer, 10, drawBakedPath);
+
+    double scanlineMs = runFrames(renderer, frames, drawScanlinePath);
+    double bakedMs = runFrames(renderer, frames, drawBakedPath);
+
+    std::cout << "Road benchmark (software renderer, " << frames << " frames, " << SCREEN_WIDTH << "x" << ROAD_HEIGHT << ")" << std::endl;
+    std::cout << "  scanline path: " << scanlineMs << " ms/frame, " << ROAD_HEIGHT << " draw calls/frame" << std::endl;
+    std::cout << "  baked path:    " << bakedMs << " ms/frame, 1 draw call/frame" << std::endl;
+    if (bakedMs > 0.0) std::cout << "  speedup:       " << scanlineMs / bakedMs << "x" << std::endl;
+
+    closeRoadRenderer();
+    SDL_DestroyTexture(gBenchRoadTexture);
+    SDL_DestroyRenderer(renderer);
+    SDL_FreeSurface(frameSurface);
+    IMG_Quit();
+    SDL_Quit();
+    return 0;
+}
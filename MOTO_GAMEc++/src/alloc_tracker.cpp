@@ -0,0 +1,104 @@
+#include <SDL.h>
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <new>
+
+#include "config.h"
+#include "alloc_tracker.h"
+#include "frame_arena.h"
+
+// --- Counters ---
+namespace {
+
+std::atomic<Uint64> sTotalAllocations{ 0 };
+std::atomic<Uint64> sTotalBytes{ 0 };
+thread_local Uint64 tAllocations = 0; // Trivial thread_locals: no allocation on first use
+thread_local Uint64 tBytes = 0;
+
+void countAllocation(std::size_t size) {
+    tAllocations++;
+    tBytes += size;
+    sTotalAllocations.fetch_add(1, std::memory_order_relaxed);
+    sTotalBytes.fetch_add(size, std::memory_order_relaxed);
+}
+
+void* countedAlloc(std::size_t size) {
+    countAllocation(size);
+    return std::malloc(size ? size : 1);
+}
+
+// Main loop frames (main thread only)
+Uint64 sFrameStart = 0;
+GameState sFrameState = GameState::LOADING;
+bool sFrameExcused = false;
+int sPlayingFrames = 0;  // Consecutive frames in PLAYING
+int sSteadyFrames = 0;
+int sAllocatingFrames = 0;
+Uint64 sSteadyAllocations = 0;
+Uint64 sWorstFrame = 0;
+
+} // namespace
+
+// --- Global Operators ---
+void* operator new(std::size_t size) {
+    void* p = countedAlloc(size);
+    if (!p) throw std::bad_alloc();
+    return p;
+}
+void* operator new[](std::size_t size) {
+    void* p = countedAlloc(size);
+    if (!p) throw std::bad_alloc();
+    return p;
+}
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept { return countedAlloc(size); }
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept { return countedAlloc(size); }
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete[](void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::size_t) noexcept { std::free(p); }
+void operator delete(void* p, const std::nothrow_t&) noexcept { std::free(p); }
+void operator delete[](void* p, const std::nothrow_t&) noexcept { std::free(p); }
+
+// --- Public Interface ---
+void noteHeapAllocation(std::size_t bytes) { countAllocation(bytes); }
+
+AllocationCounts getThreadAllocations() { return { tAllocations, tBytes }; }
+
+AllocationCounts getTotalAllocations() {
+    return { sTotalAllocations.load(std::memory_order_relaxed), sTotalBytes.load(std::memory_order_relaxed) };
+}
+
+void beginAllocationFrame(GameState state) {
+    if (state != GameState::PLAYING) sPlayingFrames = 0; // Frames that skip endAllocationFrame() still break the streak
+    sFrameStart = tAllocations;
+    sFrameState = state;
+    sFrameExcused = false;
+}
+
+void excuseAllocationFrame() { sFrameExcused = true; }
+
+void endAllocationFrame(GameState state) {
+    bool playing = sFrameState == GameState::PLAYING && state == GameState::PLAYING;
+    sPlayingFrames = playing ? sPlayingFrames + 1 : 0;
+    if (!playing || sFrameExcused || sPlayingFrames <= ALLOC_WARMUP_FRAMES) return;
+
+    sSteadyFrames++;
+    Uint64 allocations = tAllocations - sFrameStart;
+    if (allocations == 0) return;
+    if (sAllocatingFrames == 0) std::cerr << "WARNING: " << allocations << " heap allocation(s) in a steady-state PLAYING frame." << std::endl;
+    sAllocatingFrames++;
+    sSteadyAllocations += allocations;
+    if (allocations > sWorstFrame) sWorstFrame = allocations;
+    SDL_assert(allocations == 0 && "steady-state PLAYING frames must not allocate; use the frame arena");
+}
+
+void reportAllocations() {
+    AllocationCounts total = getTotalAllocations();
+    char line[224];
+    std::snprintf(line, sizeof(line), "Heap: %llu allocations (%.1f MB) in total; %d steady PLAYING frames, %d allocating (%llu allocations, worst %llu); frame arena high water %.1f KB.",
+        (unsigned long long)total.allocations, total.bytes / (1024.0 * 1024.0), sSteadyFrames, sAllocatingFrames,
+        (unsigned long long)sSteadyAllocations, (unsigned long long)sWorstFrame, getFrameArenaHighWater() / 1024.0);
+    std::cout << line << std::endl;
+}
@@ -0,0 +1,38 @@
+#ifndef ALLOC_TRACKER_H
+#define ALLOC_TRACKER_H
+
+#include <SDL.h>
+#include <cstddef>
+#include "types.h"
+
+// Heap Allocation Tracking
+// alloc_tracker.cpp replaces the global operator new/delete (plain, array and
+// nothrow forms) with counting wrappers around malloc/free. There is one counter
+// per thread and one total. The C++17 over-aligned forms keep the library
+// implementation and are not counted; nothing in the game over-aligns.
+//
+// The main loop brackets every iteration with begin/endAllocationFrame(). A frame
+// is steady-state PLAYING when the game was in PLAYING at both ends and has been
+// for ALLOC_WARMUP_FRAMES; caches, scratch vectors and the frame arena have
+// reached their working size by then. Such a frame must not allocate on the main
+// thread. Debug builds SDL_assert on it, and every build counts and reports the
+// offending frames. Transient frame data belongs in the frame arena
+// (frame_arena.h); long-lived buffers keep their capacity between frames. The
+// arena takes its own blocks with malloc and reports them through
+// noteHeapAllocation(), so a frame that spills or regrows it counts as allocating.
+
+struct AllocationCounts {
+    Uint64 allocations;
+    Uint64 bytes;
+};
+AllocationCounts getThreadAllocations(); // Calling thread, since it started
+AllocationCounts getTotalAllocations();  // Every thread
+
+void noteHeapAllocation(std::size_t bytes); // A malloc the operator new counters cannot see
+
+void beginAllocationFrame(GameState state);
+void endAllocationFrame(GameState state);
+void excuseAllocationFrame(); // This frame did deliberate one-off work (e.g. writing a trace file)
+void reportAllocations();
+
+#endif // ALLOC_TRACKER_H
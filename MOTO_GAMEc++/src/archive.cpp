@@ -0,0 +1,158 @@
+#include <SDL.h>
+#include <SDL_mixer.h>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <unordered_map>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "archive.h"
+
+// --- Mapping State ---
+namespace {
+
+const Uint8* sData = nullptr;
+size_t sSize = 0;
+std::unordered_map<std::string, const ArchiveEntry*> sIndex; // Built once, read-only afterwards (loader threads)
+
+#ifdef _WIN32
+HANDLE sFile = INVALID_HANDLE_VALUE;
+HANDLE sMapping = nullptr;
+#endif
+
+bool mapFile(const std::string& path) {
+#ifdef _WIN32
+    sFile = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (sFile == INVALID_HANDLE_VALUE) return false;
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(sFile, &size) || size.QuadPart == 0) { CloseHandle(sFile); sFile = INVALID_HANDLE_VALUE; return false; }
+    sMapping = CreateFileMappingA(sFile, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (!sMapping) { CloseHandle(sFile); sFile = INVALID_HANDLE_VALUE; return false; }
+    sData = (const Uint8*)MapViewOfFile(sMapping, FILE_MAP_READ, 0, 0, 0);
+    if (!sData) { CloseHandle(sMapping); sMapping = nullptr; CloseHandle(sFile); sFile = INVALID_HANDLE_VALUE; return false; }
+    sSize = (size_t)size.QuadPart;
+#else
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0) return false;
+    struct stat info;
+    if (fstat(fd, &info) != 0 || info.st_size == 0) { close(fd); return false; }
+    void* data = mmap(nullptr, (size_t)info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd); // The mapping keeps the file alive
+    if (data == MAP_FAILED) return false;
+    sData = (const Uint8*)data;
+    sSize = (size_t)info.st_size;
+#endif
+    return true;
+}
+
+void unmapFile() {
+#ifdef _WIN32
+    if (sData) UnmapViewOfFile(sData);
+    if (sMapping) CloseHandle(sMapping);
+    if (sFile != INVALID_HANDLE_VALUE) CloseHandle(sFile);
+    sMapping = nullptr;
+    sFile = INVALID_HANDLE_VALUE;
+#else
+    if (sData) munmap((void*)sData, sSize);
+#endif
+    sData = nullptr;
+    sSize = 0;
+}
+
+bool buildIndex() {
+    if (sSize < sizeof(ArchiveHeader)) return false;
+    ArchiveHeader header;
+    std::memcpy(&header, sData, sizeof(header));
+    if (std::memcmp(header.magic, ARCHIVE_MAGIC, sizeof(header.magic)) != 0 || header.version != ARCHIVE_VERSION) return false;
+    if (header.indexOffset > sSize || (sSize - header.indexOffset) / sizeof(ArchiveEntry) < header.entryCount) return false;
+    if (header.indexOffset % alignof(ArchiveEntry) != 0) return false;
+
+    const ArchiveEntry* entries = (const ArchiveEntry*)(sData + header.indexOffset);
+    for (Uint32 i = 0; i < header.entryCount; ++i) {
+        const ArchiveEntry& e = entries[i];
+        if (e.offset > sSize || e.size > sSize - e.offset) return false;
+        std::string name(e.name, strnlen(e.name, ARCHIVE_NAME_SIZE));
+        sIndex[name] = &e;
+    }
+    return true;
+}
+
+// "../assets/images/Intro/x.png" -> "images/intro/x.png"
+std::string keyForPath(const std::string& path) {
+    std::string key = normalizeArchiveName(path);
+    size_t root = key.rfind("assets/");
+    return root == std::string::npos ? key : key.substr(root + 7);
+}
+
+} // namespace
+
+// --- Archive ---
+bool openAssetArchive() {
+    if (sData) return true;
+    char* base = SDL_GetBasePath();
+    std::string path = std::string(base ? base : "") + ARCHIVE_FILE_NAME;
+    SDL_free(base);
+
+    if (!mapFile(path)) {
+        std::cout << " -> No asset archive at " << path << ", loading loose files." << std::endl;
+        return false;
+    }
+    if (!buildIndex()) {
+        std::cerr << "WARNING: Asset archive " << path << " is invalid or outdated, loading loose files." << std::endl;
+        closeAssetArchive();
+        return false;
+    }
+    std::cout << " -> Mapped asset archive " << path << " (" << sIndex.size() << " entries, " << sSize / 1024 << " KB)." << std::endl;
+    return true;
+}
+
+void closeAssetArchive() {
+    sIndex.clear();
+    unmapFile();
+}
+
+bool hasAssetArchive() { return sData != nullptr; }
+
+const ArchiveEntry* findArchiveEntry(const std::string& path) {
+    if (!sData) return nullptr;
+    auto it = sIndex.find(keyForPath(path));
+    return it == sIndex.end() ? nullptr : it->second;
+}
+
+SDL_Surface* createArchiveSurface(const ArchiveEntry* entry) {
+    if (!entry || entry->kind != (Uint32)ArchiveEntryKind::PIXELS) return nullptr;
+    // SDL never writes through a source surface, so the read-only mapping is safe here
+    return SDL_CreateRGBSurfaceWithFormatFrom((void*)(sData + entry->offset), (int)entry->width, (int)entry->height,
+                                              SDL_BITSPERPIXEL(entry->format), (int)entry->pitch, entry->format);
+}
+
+Mix_Chunk* createArchiveChunk(const ArchiveEntry* entry) {
+    if (!entry || entry->kind != (Uint32)ArchiveEntryKind::PCM) return nullptr;
+    if (entry->format != AUDIO_SAMPLE_FORMAT || (int)entry->width != AUDIO_FREQUENCY || (int)entry->height != AUDIO_CHANNELS) return nullptr;
+    return Mix_QuickLoad_RAW((Uint8*)(sData + entry->offset), (Uint32)entry->size); // Not copied, not freed by Mix_FreeChunk
+}
+
+SDL_RWops* openAssetRW(const std::string& path) {
+    const ArchiveEntry* entry = findArchiveEntry(path);
+    if (entry && entry->kind == (Uint32)ArchiveEntryKind::BLOB) return SDL_RWFromConstMem(sData + entry->offset, (int)entry->size);
+    return SDL_RWFromFile(path.c_str(), "rb");
+}
+
+bool readAssetText(const std::string& path, std::string& out) {
+    SDL_RWops* rw = openAssetRW(path);
+    if (!rw) return false;
+    Sint64 size = SDL_RWsize(rw);
+    out.assign(size > 0 ? (size_t)size : 0, '\0');
+    bool ok = size >= 0 && (size == 0 || SDL_RWread(rw, &out[0], 1, (size_t)size) == (size_t)size);
+    SDL_RWclose(rw);
+    return ok;
+}
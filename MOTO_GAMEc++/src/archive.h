@@ -0,0 +1,27 @@
+#ifndef ARCHIVE_H
+#define ARCHIVE_H
+
+#include <SDL.h>
+#include <SDL_mixer.h>
+#include <string>
+#include "archive_format.h"
+
+// Memory-Mapped Asset Archive
+// assets.pak (built by tools/asset_packer.cpp) is mapped read-only at startup.
+// Images come out as zero-copy surfaces over the mapped pixels and short sounds
+// as chunks over the mapped PCM, so nothing is decompressed or opened per file.
+// Lookups take the game's usual "../assets/..." paths; without an archive every
+// function below returns nullptr and callers fall back to loading the file.
+// The archive must stay open until every surface, chunk and RWops from it is freed.
+
+bool openAssetArchive(); // Looks next to the executable; false (not an error) if absent
+void closeAssetArchive();
+bool hasAssetArchive();
+
+const ArchiveEntry* findArchiveEntry(const std::string& path);
+SDL_Surface* createArchiveSurface(const ArchiveEntry* entry); // Pixels stay in the mapping
+Mix_Chunk* createArchiveChunk(const ArchiveEntry* entry);
+SDL_RWops* openAssetRW(const std::string& path);              // Archive bytes, else the file
+bool readAssetText(const std::string& path, std::string& out); // Whole asset through openAssetRW
+
+#endif // ARCHIVE_H
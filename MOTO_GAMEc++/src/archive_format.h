@@ -0,0 +1,57 @@
+#ifndef ARCHIVE_FORMAT_H
+#define ARCHIVE_FORMAT_H
+
+#include <SDL.h>
+#include <cctype>
+#include <string>
+
+// Packed Asset Archive Layout (shared by tools/asset_packer.cpp and archive.cpp)
+//   ArchiveHeader | entry data (each ARCHIVE_ALIGNMENT-aligned) | ArchiveEntry[entryCount]
+// All fields are little-endian, which covers every platform the game ships on.
+
+const char ARCHIVE_MAGIC[8] = { 'M', 'O', 'T', 'O', 'P', 'A', 'K', '1' };
+const Uint32 ARCHIVE_VERSION = 1;
+const Uint64 ARCHIVE_ALIGNMENT = 16;
+const int ARCHIVE_NAME_SIZE = 96;
+const char* const ARCHIVE_FILE_NAME = "assets.pak"; // Next to the executable
+
+// Mixer output format; short sounds are stored pre-converted to it
+const int AUDIO_FREQUENCY = 44100;
+const int AUDIO_CHANNELS = 2;
+const SDL_AudioFormat AUDIO_SAMPLE_FORMAT = AUDIO_S16SYS;
+
+enum class ArchiveEntryKind : Uint32 {
+    BLOB = 0,   // Original file bytes (fonts, streamed audio)
+    PIXELS = 1, // Decoded pixels: format, width, height, pitch
+    PCM = 2     // Raw samples at the mixer format: format, width = frequency, height = channels
+};
+
+struct ArchiveHeader {
+    char magic[8];
+    Uint32 version;
+    Uint32 entryCount;
+    Uint64 indexOffset;
+};
+
+struct ArchiveEntry {
+    char name[ARCHIVE_NAME_SIZE]; // Lower-case path relative to assets/, '/' separated
+    Uint32 kind;
+    Uint32 format;
+    Uint32 width;
+    Uint32 height;
+    Uint32 pitch;
+    Uint32 reserved;
+    Uint64 offset;
+    Uint64 size;
+};
+
+// Entry names are case-insensitive and use '/' on every platform
+inline std::string normalizeArchiveName(std::string name) {
+    for (char& c : name) c = (c == '\\') ? '/' : (char)std::tolower((unsigned char)c);
+    return name;
+}
+
+static_assert(sizeof(ArchiveHeader) == 24, "ArchiveHeader layout changed");
+static_assert(sizeof(ArchiveEntry) == 136, "ArchiveEntry layout changed");
+
+#endif // ARCHIVE_FORMAT_H
@@ -0,0 +1,353 @@
+#include <SDL.h>
+#include <SDL_image.h>
+#include <SDL_mixer.h>
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstdio>
+#include <deque>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "assets.h"
+#include "audio.h"
+#include "archive.h"
+#include "thread_pool.h"
+
+// --- Loader State ---
+namespace {
+
+enum class AssetKind { TEXTURE, SURFACE, CHUNK };
+
+struct AssetRequest {
+    std::string path;
+    AssetKind kind;
+    SDL_Texture** texture;
+    Mix_Chunk** chunk;
+    AssetGroup group;
+    bool required;
+    TextureReadyCallback onReady;
+    SurfaceReadyCallback onDecoded;
+    AssetSize size;
+};
+
+// Produced on a worker, consumed on the render thread
+struct DecodedAsset {
+    size_t index;
+    SDL_Surface* surface;
+    Mix_Chunk* chunk;
+    std::string error;
+};
+
+std::deque<AssetRequest> sRequests; // Render thread only; workers get their own copy of the path
+std::unique_ptr<ThreadPool> sPool;
+std::mutex sResultMutex;
+std::condition_variable sResultReady;
+std::deque<DecodedAsset> sResults;
+std::atomic<bool> sCancelled{ false };
+
+size_t sDelivered = 0;
+size_t sStartupCount = 0; // Requests queued before startAssetLoading(); only these are reloadable
+bool sStartupReported = false;
+int sGroupPending[(int)AssetGroup::COUNT] = {};
+bool sFailed = false;
+Uint64 sStartCounter = 0;
+
+// Bilinear resample to the drawn size; on any failure the original is kept and SDL
+// scales it at draw time as before
+SDL_Surface* resampleSurface(SDL_Surface* surface, const AssetSize& size) {
+    int w = size.w > 0 ? size.w : (int)(surface->w * size.scale);
+    int h = size.h > 0 ? size.h : (int)(surface->h * size.scale);
+    if (w <= 0 || h <= 0 || w > surface->w || h > surface->h || (w == surface->w && h == surface->h)) return surface;
+    SDL_Surface* source = surface;
+    if (surface->format->format != SDL_PIXELFORMAT_ARGB8888) source = SDL_ConvertSurfaceFormat(surface, SDL_PIXELFORMAT_ARGB8888, 0);
+    SDL_Surface* scaled = source ? SDL_CreateRGBSurfaceWithFormat(0, w, h, 32, SDL_PIXELFORMAT_ARGB8888) : nullptr;
+    if (scaled && SDL_SoftStretchLinear(source, nullptr, scaled, nullptr) != 0) { SDL_FreeSurface(scaled); scaled = nullptr; }
+    if (source && source != surface) SDL_FreeSurface(source);
+    if (!scaled) return surface;
+    SDL_FreeSurface(surface);
+    return scaled;
+}
+
+void decodeAsset(size_t index, const std::string& path, AssetKind kind, AssetSize size) {
+    DecodedAsset result = { index, nullptr, nullptr, std::string() };
+    if (!sCancelled) {
+        if (kind != AssetKind::CHUNK) {
+            result.surface = createArchiveSurface(findArchiveEntry(path)); // Zero-copy when packed
+            if (!result.surface) result.surface = IMG_Load(path.c_str());
+            if (!result.surface) result.error = IMG_GetError(); // SDL errors are per-thread
+            else result.surface = resampleSurface(result.surface, size);
+        } else {
+            result.chunk = createArchiveChunk(findArchiveEntry(path));
+            if (!result.chunk) result.chunk = Mix_LoadWAV_RW(openAssetRW(path), 1);
+            if (!result.chunk) result.error = Mix_GetError();
+        }
+    }
+    {
+        std::lock_guard<std::mutex> lock(sResultMutex);
+        sResults.push_back(std::move(result));
+    }
+    sResultReady.notify_all();
+}
+
+void deliverAsset(DecodedAsset& result, SDL_Renderer* renderer) {
+    AssetRequest& req = sRequests[result.index];
+    if (req.kind == AssetKind::TEXTURE) {
+        SDL_Texture* newTexture = nullptr;
+        if (result.surface == nullptr) {
+            std::cerr << "ERROR: Unable to load image " << req.path << "! SDL_image Error: " << result.error << std::endl;
+        } else {
+            newTexture = SDL_CreateTextureFromSurface(renderer, result.surface);
+            if (newTexture == nullptr) { std::cerr << "ERROR: Unable to create texture from " << req.path << "! SDL Error: " << SDL_GetError() << std::endl; }
+            SDL_FreeSurface(result.surface);
+            result.surface = nullptr;
+        }
+        *req.texture = newTexture;
+        if (newTexture && result.index < sStartupCount) registerGroupTexture(req.texture, req.group);
+        if (newTexture && req.onReady) req.onReady(newTexture);
+        if (!newTexture && req.required) sFailed = true;
+    } else if (req.kind == AssetKind::SURFACE) {
+        if (result.surface == nullptr) { std::cerr << "ERROR: Unable to load image " << req.path << "! SDL_image Error: " << result.error << std::endl; }
+        if (result.surface == nullptr && req.required) sFailed = true;
+        req.onDecoded(result.surface, renderer);
+        result.surface = nullptr;
+    } else {
+        *req.chunk = result.chunk;
+        trackPreloadedChunk(req.chunk);
+        if (result.chunk == nullptr) { std::cerr << "WARNING: Failed to load sound " << req.path << "! SDL_mixer Error: " << result.error << std::endl; }
+    }
+
+    sDelivered++;
+    sGroupPending[(int)req.group]--;
+    if (sDelivered == sRequests.size() && !sStartupReported) {
+        sStartupReported = true;
+        double ms = (double)(SDL_GetPerformanceCounter() - sStartCounter) * 1000.0 / SDL_GetPerformanceFrequency();
+        std::cout << "Media Loading Complete (" << sDelivered << " assets, " << ms << " ms)." << std::endl;
+    }
+}
+
+void submitRequest(size_t index) {
+    const AssetRequest& req = sRequests[index];
+    std::string path = req.path;
+    AssetKind kind = req.kind;
+    AssetSize size = req.size;
+    sPool->enqueue([index, path, kind, size] { decodeAsset(index, path, kind, size); });
+}
+
+bool popResult(DecodedAsset& out) {
+    std::lock_guard<std::mutex> lock(sResultMutex);
+    if (sResults.empty()) return false;
+    out = std::move(sResults.front());
+    sResults.pop_front();
+    return true;
+}
+
+} // namespace
+
+// --- Queueing ---
+void queueTextureLoad(const std::string& path, SDL_Texture** target, AssetGroup group, bool required, TextureReadyCallback onReady, AssetSize size) {
+    *target = nullptr;
+    sRequests.push_back({ path, AssetKind::TEXTURE, target, nullptr, group, required, std::move(onReady), nullptr, size });
+    sGroupPending[(int)group]++;
+    if (sPool) submitRequest(sRequests.size() - 1); // On-demand request after startup
+}
+
+void queueChunkLoad(const std::string& path, Mix_Chunk** target, AssetGroup group) {
+    *target = nullptr;
+    sRequests.push_back({ path, AssetKind::CHUNK, nullptr, target, group, false, nullptr, nullptr, AssetSize() });
+    sGroupPending[(int)group]++;
+    if (sPool) submitRequest(sRequests.size() - 1); // On-demand request after startup
+}
+
+void queueSurfaceLoad(const std::string& path, AssetGroup group, bool required, SurfaceReadyCallback onDecoded, AssetSize size) {
+    sRequests.push_back({ path, AssetKind::SURFACE, nullptr, nullptr, group, required, nullptr, std::move(onDecoded), size });
+    sGroupPending[(int)group]++;
+    if (sPool) submitRequest(sRequests.size() - 1); // On-demand request after startup
+}
+
+bool startAssetLoading() {
+    if (sPool) return true;
+    sCancelled = false;
+    sStartCounter = SDL_GetPerformanceCounter();
+    sStartupCount = sRequests.size();
+    sPool.reset(new ThreadPool(ThreadPool::defaultThreadCount()));
+    std::cout << " -> Decoding " << sRequests.size() << " assets on " << sPool->size() << " worker thread(s)." << std::endl;
+    for (size_t i = 0; i < sRequests.size(); ++i) submitRequest(i);
+    return true;
+}
+
+// --- Render Thread ---
+void pumpAssetLoader(SDL_Renderer* renderer, float budgetMs) {
+    Uint64 start = SDL_GetPerformanceCounter();
+    Uint64 budgetTicks = (Uint64)(budgetMs * 0.001 * SDL_GetPerformanceFrequency());
+    DecodedAsset result;
+    while (popResult(result)) {
+        deliverAsset(result, renderer);
+        if (SDL_GetPerformanceCounter() - start >= budgetTicks) break;
+    }
+}
+
+void waitForAssetGroup(AssetGroup group, SDL_Renderer* renderer) {
+    while (sGroupPending[(int)group] > 0 && !sFailed) {
+        DecodedAsset result;
+        {
+            std::unique_lock<std::mutex> lock(sResultMutex);
+            sResultReady.wait(lock, [] { return !sResults.empty(); });
+            result = std::move(sResults.front());
+            sResults.pop_front();
+        }
+        deliverAsset(result, renderer);
+    }
+}
+
+bool isAssetGroupReady(AssetGroup group) { return sGroupPending[(int)group] <= 0; }
+bool isAssetLoadingComplete() { return sDelivered == sRequests.size(); }
+bool hasAssetLoadingFailed() { return sFailed; }
+
+float getAssetLoadProgress() {
+    return sRequests.empty() ? 1.0f : (float)sDelivered / (float)sRequests.size();
+}
+
+void shutdownAssetLoader() {
+    sCancelled = true;
+    sPool.reset(); // Joins workers; cancelled jobs finish immediately
+    for (auto& result : sResults) {
+        if (result.surface) SDL_FreeSurface(result.surface);
+        if (result.chunk) Mix_FreeChunk(result.chunk);
+    }
+    sResults.clear();
+    sRequests.clear();
+    sDelivered = 0;
+    sStartupCount = 0;
+    sStartupReported = false;
+    for (int& pending : sGroupPending) pending = 0;
+}
+
+// --- Texture Residency ---
+namespace {
+
+struct ResidentTexture {
+    SDL_Texture** owner;
+    size_t bytes;
+};
+
+struct GroupResidency {
+    std::vector<ResidentTexture> textures;
+    size_t bytes = 0;
+    Uint64 lastUsed = 0; // useAssetGroups() call that last named the group
+    bool evicted = false;
+    int evictions = 0;
+    int reloads = 0;
+};
+
+const char* const GROUP_NAMES[(int)AssetGroup::COUNT] = { "menu", "about", "character select", "intro", "gameplay" };
+GroupResidency sResidency[(int)AssetGroup::COUNT];
+size_t sTextureBudget = 0;
+size_t sResidentBytes = 0;
+Uint64 sUseStamp = 0;
+
+size_t textureBytes(SDL_Texture* texture) {
+    Uint32 format;
+    int w, h;
+    if (SDL_QueryTexture(texture, &format, nullptr, &w, &h) != 0) return 0;
+    int bytesPerPixel = SDL_ISPIXELFORMAT_FOURCC(format) ? 4 : SDL_BYTESPERPIXEL(format); // Planar YUV: upper bound
+    return (size_t)w * h * bytesPerPixel;
+}
+
+void evictGroup(AssetGroup group) {
+    GroupResidency& r = sResidency[(int)group];
+    for (ResidentTexture& t : r.textures) {
+        if (*t.owner) { SDL_DestroyTexture(*t.owner); *t.owner = nullptr; }
+    }
+    sResidentBytes -= r.bytes;
+    r.bytes = 0;
+    r.textures.clear();
+    r.evicted = true;
+    r.evictions++;
+}
+
+// Re-submits the group's startup requests; the sprite atlas repacks as the surfaces arrive
+void reloadGroup(AssetGroup group, SDL_Renderer* renderer) {
+    GroupResidency& r = sResidency[(int)group];
+    r.evicted = false;
+    if (!sPool) return;
+    for (size_t i = 0; i < sStartupCount; ++i) {
+        if (sRequests[i].group != group || sRequests[i].kind == AssetKind::CHUNK) continue;
+        sGroupPending[(int)group]++;
+        sDelivered--;
+        submitRequest(i);
+    }
+    r.reloads++;
+    waitForAssetGroup(group, renderer);
+}
+
+void enforceTextureBudget() {
+    while (sTextureBudget > 0 && sResidentBytes > sTextureBudget) {
+        int victim = -1;
+        for (int g = 0; g < (int)AssetGroup::COUNT; ++g) {
+            const GroupResidency& r = sResidency[g];
+            if (r.bytes == 0 || r.lastUsed == sUseStamp || sGroupPending[g] > 0) continue; // In use or still arriving
+            if (victim < 0 || r.lastUsed < sResidency[victim].lastUsed) victim = g;
+        }
+        if (victim < 0) return; // The screen in use alone is over budget
+        evictGroup((AssetGroup)victim);
+    }
+}
+
+} // namespace
+
+void registerGroupTexture(SDL_Texture** owner, AssetGroup group) {
+    if (!owner || !*owner) return;
+    GroupResidency& r = sResidency[(int)group];
+    size_t bytes = textureBytes(*owner);
+    auto it = std::find_if(r.textures.begin(), r.textures.end(), [owner](const ResidentTexture& t) { return t.owner == owner; });
+    if (it != r.textures.end()) {
+        r.bytes -= it->bytes;
+        sResidentBytes -= it->bytes;
+        it->bytes = bytes;
+    } else {
+        r.textures.push_back({ owner, bytes });
+    }
+    r.bytes += bytes;
+    sResidentBytes += bytes;
+    r.evicted = false;
+}
+
+void setTextureBudget(size_t bytes) { sTextureBudget = bytes; }
+
+void useAssetGroups(std::initializer_list<AssetGroup> groups, SDL_Renderer* renderer) {
+    sUseStamp++;
+    for (AssetGroup group : groups) {
+        GroupResidency& r = sResidency[(int)group];
+        r.lastUsed = sUseStamp;
+        if (r.evicted) reloadGroup(group, renderer);
+    }
+    enforceTextureBudget();
+}
+
+size_t getResidentTextureBytes() { return sResidentBytes; }
+
+void reportTextureResidency() {
+    char line[160];
+    std::snprintf(line, sizeof(line), "Texture memory: %.1f MB resident (budget: %s).", sResidentBytes / (1024.0 * 1024.0),
+        sTextureBudget > 0 ? (std::to_string(sTextureBudget / (1024 * 1024)) + " MB").c_str() : "unlimited");
+    std::cout << line << std::endl;
+    for (int g = 0; g < (int)AssetGroup::COUNT; ++g) {
+        const GroupResidency& r = sResidency[g];
+        std::snprintf(line, sizeof(line), "  %-17s %6.2f MB in %2d texture(s), %d eviction(s), %d reload(s)", GROUP_NAMES[g], r.bytes / (1024.0 * 1024.0), (int)r.textures.size(), r.evictions, r.reloads);
+        std::cout << line << std::endl;
+    }
+}
+
+void freeGroupTextures() {
+    for (GroupResidency& r : sResidency) {
+        for (ResidentTexture& t : r.textures) {
+            if (*t.owner) { SDL_DestroyTexture(*t.owner); *t.owner = nullptr; }
+        }
+        r = GroupResidency();
+    }
+    sResidentBytes = 0;
+}
@@ -0,0 +1,78 @@
+#ifndef ASSETS_H
+#define ASSETS_H
+
+#include <SDL.h>
+#include <SDL_mixer.h>
+#include <cstddef>
+#include <functional>
+#include <initializer_list>
+#include <string>
+
+// Asynchronous Asset Loader
+// PNG/JPG decoding (IMG_Load) and WAV decoding (Mix_LoadWAV) run on a thread pool.
+// Only SDL_CreateTextureFromSurface runs on the render thread, inside
+// pumpAssetLoader(), so the loading screen and the menu keep drawing while the
+// rest of the game decodes. Results are written straight into the target globals.
+
+// Assets are grouped by the screen that needs them; a group is ready once every
+// asset queued in it has been delivered (successfully or not).
+enum class AssetGroup {
+    MENU,
+    ABOUT,
+    CHARACTER_SELECT,
+    INTRO,
+    GAMEPLAY,
+    COUNT
+};
+
+using TextureReadyCallback = std::function<void(SDL_Texture*)>;
+using SurfaceReadyCallback = std::function<void(SDL_Surface*, SDL_Renderer*)>; // Takes ownership; nullptr on failure
+
+// Pre-scaled decoding: images are resampled on the worker to the size they are drawn
+// at, so the GPU keeps no more pixels than reach the screen and draws copy 1:1.
+// w/h > 0 give the exact size, otherwise scale applies. Images are never enlarged.
+struct AssetSize {
+    int w = 0;
+    int h = 0;
+    float scale = 1.0f;
+};
+inline AssetSize exactSize(int w, int h) { AssetSize s; s.w = w; s.h = h; return s; }
+inline AssetSize scaledSize(float scale) { AssetSize s; s.scale = scale; return s; }
+
+// Requests queued before startAssetLoading() form the startup set; requests queued
+// afterwards are decoded on demand (intro streaming). Required assets abort the game
+// when they fail.
+void queueTextureLoad(const std::string& path, SDL_Texture** target, AssetGroup group, bool required = false, TextureReadyCallback onReady = nullptr, AssetSize size = AssetSize());
+void queueChunkLoad(const std::string& path, Mix_Chunk** target, AssetGroup group);
+// Decoded surface handed to onDecoded on the render thread instead of being uploaded (atlas packing)
+void queueSurfaceLoad(const std::string& path, AssetGroup group, bool required, SurfaceReadyCallback onDecoded, AssetSize size = AssetSize());
+bool startAssetLoading();
+
+// Render thread: upload decoded surfaces for up to budgetMs (always at least one).
+void pumpAssetLoader(SDL_Renderer* renderer, float budgetMs);
+// Render thread: block until a group is delivered (used when a screen is entered early).
+void waitForAssetGroup(AssetGroup group, SDL_Renderer* renderer);
+
+bool isAssetGroupReady(AssetGroup group);
+bool isAssetLoadingComplete();
+bool hasAssetLoadingFailed();
+float getAssetLoadProgress(); // 0..1
+
+void shutdownAssetLoader(); // Cancels pending work and frees anything not yet delivered
+
+// --- Texture Residency ---
+// Every texture of the startup set (loader textures and sprite atlas pages) is
+// registered with its size in bytes under its AssetGroup. Each frame the current
+// screen names the groups it draws with useAssetGroups(). While the registered total
+// is over the budget, groups not in use are evicted least recently used first: their
+// textures are destroyed and the owners' pointers nulled. An evicted group is decoded
+// again (blocking) the next time a screen uses it. On-demand loads such as intro
+// slides are owned by their callers and are not counted.
+void registerGroupTexture(SDL_Texture** owner, AssetGroup group); // Re-registering an owner updates it
+void setTextureBudget(size_t bytes); // 0 = unlimited (default)
+void useAssetGroups(std::initializer_list<AssetGroup> groups, SDL_Renderer* renderer);
+size_t getResidentTextureBytes();
+void reportTextureResidency(); // Resident bytes per group, evictions and reloads
+void freeGroupTextures();      // Shutdown: destroys every registered texture
+
+#endif // ASSETS_H
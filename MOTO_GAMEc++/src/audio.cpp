@@ -0,0 +1,112 @@
+#include <SDL.h>
+#include <SDL_mixer.h>
+#include <cstdio>
+#include <iostream>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "globals.h"
+#include "audio.h"
+#include "archive.h"
+
+// --- Stream State ---
+namespace {
+
+const char* const STREAM_EXTENSIONS[] = { ".ogg", ".flac", ".wav" }; // Preferred first
+
+Mix_Music* sCurrentStream = nullptr;
+std::map<std::string, size_t> sStreamDecodedBytes; // Resolved path -> PCM size at mixer format
+std::vector<Mix_Chunk* const*> sTrackedChunks;
+
+bool fileExists(const std::string& path) {
+    if (findArchiveEntry(path)) return true;
+    SDL_RWops* file = SDL_RWFromFile(path.c_str(), "rb");
+    if (!file) return false;
+    SDL_RWclose(file);
+    return true;
+}
+
+size_t bytesPerMixerSecond() {
+    int frequency = 0, channels = 0;
+    Uint16 format = 0;
+    if (Mix_QuerySpec(&frequency, &format, &channels) == 0) return 0;
+    return (size_t)frequency * channels * (SDL_AUDIO_BITSIZE(format) / 8);
+}
+
+} // namespace
+
+// --- Codecs & Paths ---
+bool initAudioCodecs() {
+    int wanted = MIX_INIT_OGG | MIX_INIT_FLAC;
+    int available = Mix_Init(wanted);
+    std::cout << " -> Audio codecs: WAV" << ((available & MIX_INIT_OGG) ? ", OGG" : "") << ((available & MIX_INIT_FLAC) ? ", FLAC" : "") << std::endl;
+    if ((available & wanted) != wanted) { std::cerr << "WARNING: Some compressed audio formats are unavailable, falling back to WAV. SDL_mixer Error: " << Mix_GetError() << std::endl; }
+    return true;
+}
+
+std::string resolveAudioPath(const std::string& basePath) {
+    for (const char* ext : STREAM_EXTENSIONS) {
+        std::string path = basePath + ext;
+        if (fileExists(path)) return path;
+    }
+    return basePath + ".wav"; // Let Mix_LoadMUS report the missing file
+}
+
+// --- Streams ---
+Mix_Music* openStream(const std::string& basePath) {
+    std::string path = resolveAudioPath(basePath);
+    Mix_Music* stream = Mix_LoadMUS_RW(openAssetRW(path), 1); // Streams from the mapped archive when packed
+    if (stream == nullptr) { std::cerr << "WARNING: Failed to open audio stream " << path << "! SDL_mixer Error: " << Mix_GetError() << std::endl; return nullptr; }
+    if (sStreamDecodedBytes.find(path) == sStreamDecodedBytes.end()) {
+        double seconds = Mix_MusicDuration(stream);
+        sStreamDecodedBytes[path] = seconds > 0.0 ? (size_t)(seconds * bytesPerMixerSecond()) : 0;
+    }
+    return stream;
+}
+
+void closeStream(Mix_Music*& stream) {
+    if (!stream) return;
+    if (stream == sCurrentStream) { Mix_HaltMusic(); sCurrentStream = nullptr; }
+    Mix_FreeMusic(stream);
+    stream = nullptr;
+}
+
+bool playStream(Mix_Music* stream, int loops) {
+    if (!stream) return false;
+    if (Mix_PlayMusic(stream, loops) == -1) { std::cerr << "WARNING: Could not play audio stream! SDL_mixer Error: " << Mix_GetError() << std::endl; sCurrentStream = nullptr; return false; }
+    sCurrentStream = stream;
+    return true;
+}
+
+void stopStream() {
+    if (Mix_PlayingMusic()) { Mix_HaltMusic(); }
+    sCurrentStream = nullptr;
+}
+
+bool isStreamPlaying(Mix_Music* stream) {
+    return stream != nullptr && stream == sCurrentStream && Mix_PlayingMusic() != 0;
+}
+
+void playMenuMusic() {
+    if (gMenuMusic == nullptr || isStreamPlaying(gMenuMusic)) return;
+    playStream(gMenuMusic, -1);
+}
+
+// --- Memory Report ---
+void trackPreloadedChunk(Mix_Chunk* const* slot) { sTrackedChunks.push_back(slot); }
+
+void reportAudioMemory() {
+    size_t chunkBytes = 0;
+    int chunkCount = 0;
+    for (Mix_Chunk* const* slot : sTrackedChunks) {
+        if (*slot) { chunkBytes += (*slot)->alen; chunkCount++; }
+    }
+    size_t streamBytes = 0;
+    for (const auto& entry : sStreamDecodedBytes) streamBytes += entry.second;
+
+    char line[256];
+    std::snprintf(line, sizeof(line), "Audio memory: %.1f MB resident (%d preloaded SFX); %zu streamed sound(s) would hold %.1f MB if fully decoded (before: %.1f MB).",
+                  chunkBytes / (1024.0 * 1024.0), chunkCount, sStreamDecodedBytes.size(), streamBytes / (1024.0 * 1024.0), (chunkBytes + streamBytes) / (1024.0 * 1024.0));
+    std::cout << line << std::endl;
+}
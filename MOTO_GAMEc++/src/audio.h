@@ -0,0 +1,27 @@
+#ifndef AUDIO_H
+#define AUDIO_H
+
+#include <SDL_mixer.h>
+#include <string>
+
+// Audio Layer
+// Short SFX are preloaded as fully decoded Mix_Chunks (queueChunkLoad). Long sounds
+// (menu music, intro narration, win/lose stings) are opened with Mix_LoadMUS and
+// streamed from disk in small buffers on the music channel instead, so only their
+// decoder state is resident. Only one stream plays at a time.
+// Stream paths are given without an extension and resolved as .ogg, .flac, then .wav.
+
+bool initAudioCodecs(); // Call before Mix_OpenAudio; WAV always works, OGG/FLAC if available
+std::string resolveAudioPath(const std::string& basePath);
+Mix_Music* openStream(const std::string& basePath); // nullptr on failure (already reported)
+void closeStream(Mix_Music*& stream);               // Halts it first if it is playing
+bool playStream(Mix_Music* stream, int loops = 0);  // Replaces whatever is on the music channel
+void stopStream();
+bool isStreamPlaying(Mix_Music* stream);
+void playMenuMusic(); // Restarts the menu loop unless it is already the current stream
+
+// Bytes held by preloaded chunks vs. what every opened stream would cost fully decoded
+void trackPreloadedChunk(Mix_Chunk* const* slot);
+void reportAudioMemory();
+
+#endif // AUDIO_H
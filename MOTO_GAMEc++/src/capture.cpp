@@ -0,0 +1,279 @@
+#include <SDL.h>
+#include <SDL_image.h>
+#include <algorithm>
+#include <condition_variable>
+#include <cstdio>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+#include "config.h"
+#include "capture.h"
+#include "resolution.h"
+
+// --- Buffer Pool and Writer Queue ---
+namespace {
+
+const int CAPTURE_PITCH = SCREEN_WIDTH * 4;
+
+struct CaptureBuffer {
+    std::vector<Uint8> pixels; // ARGB8888, room for a full-size scene
+    int w = 0;
+    int h = 0;
+    Uint64 sequence = 0;       // Capture slot on the wall clock; gaps are idle time or dropped frames
+};
+
+// Free list and FIFO of filled buffers, as index arrays: the game thread never allocates
+CaptureBuffer sBuffers[CAPTURE_BUFFER_COUNT];
+int sFree[CAPTURE_BUFFER_COUNT];
+int sFreeCount = 0;
+int sQueue[CAPTURE_BUFFER_COUNT];
+int sQueueHead = 0;
+int sQueueCount = 0;
+bool sStopping = false;
+std::mutex sMutex;
+std::condition_variable sWake;
+std::thread sWriter;
+
+bool sActive = false;
+bool sVideo = false;
+std::string sPath;
+int sEveryNth = 1;
+int sFps = PACER_DEFAULT_TARGET_FPS;
+bool sPerPresent = false; // Offline renders: one slot per presented frame
+std::FILE* sVideoFile = nullptr;
+Uint64 sEndSequence = 0;  // Slots the video must fill when it stops; guarded by sMutex
+
+// Game thread
+Uint64 sStartCounter = 0;
+Uint64 sNextSequence = 0; // First slot still without a frame
+Uint64 sPresented = 0;
+Uint64 sCaptured = 0;
+Uint64 sDropped = 0;    // Every buffer was still waiting for the writer
+Uint64 sUnreadable = 0; // No finished scene to read back
+double sReadbackMsSum = 0.0;
+double sReadbackMsMax = 0.0;
+
+// Writer thread; read by the game thread only after the join
+Uint64 sWritten = 0;
+Uint64 sRepeated = 0;   // Video: earlier frames written again in place of dropped ones
+bool sWriteFailed = false;
+
+bool endsWith(const std::string& text, const std::string& suffix) {
+    return text.size() >= suffix.size() && text.compare(text.size() - suffix.size(), suffix.size(), suffix) == 0;
+}
+
+bool writePng(const CaptureBuffer& buffer) {
+    // RGB888 ignores the top byte, so the PNG is opaque whatever alpha the target held
+    SDL_Surface* surface = SDL_CreateRGBSurfaceWithFormatFrom((void*)buffer.pixels.data(), buffer.w, buffer.h, 32, CAPTURE_PITCH, SDL_PIXELFORMAT_RGB888);
+    if (!surface) return false;
+    char suffix[32];
+    std::snprintf(suffix, sizeof(suffix), "_%06llu.png", (unsigned long long)buffer.sequence);
+    bool ok = IMG_SavePNG(surface, (sPath + suffix).c_str()) == 0;
+    SDL_FreeSurface(surface);
+    return ok;
+}
+
+// BT.601 studio range, chroma averaged over each 2x2 block (odd edges use what exists)
+void convertToI420(const Uint8* pixels, int pitch, std::vector<Uint8>& yuv) {
+    const int w = SCREEN_WIDTH, h = SCREEN_HEIGHT, cw = (w + 1) / 2, ch = (h + 1) / 2;
+    yuv.resize((size_t)w * h + 2 * (size_t)cw * ch);
+    Uint8* yPlane = yuv.data();
+    Uint8* uPlane = yPlane + (size_t)w * h;
+    Uint8* vPlane = uPlane + (size_t)cw * ch;
+    auto pixel = [&](int x, int y) { return *reinterpret_cast<const Uint32*>(pixels + (size_t)y * pitch + (size_t)x * 4); };
+    for (int y = 0; y < h; ++y) {
+        for (int x = 0; x < w; ++x) {
+            Uint32 p = pixel(x, y);
+            int r = (p >> 16) & 0xFF, g = (p >> 8) & 0xFF, b = p & 0xFF;
+            yPlane[(size_t)y * w + x] = (Uint8)(16 + ((66 * r + 129 * g + 25 * b + 128) >> 8));
+        }
+    }
+    for (int cy = 0; cy < ch; ++cy) {
+        for (int cx = 0; cx < cw; ++cx) {
+            int r = 0, g = 0, b = 0, n = 0;
+            for (int y = cy * 2; y < std::min(cy * 2 + 2, h); ++y) {
+                for (int x = cx * 2; x < std::min(cx * 2 + 2, w); ++x) {
+                    Uint32 p = pixel(x, y);
+                    r += (p >> 16) & 0xFF; g += (p >> 8) & 0xFF; b += p & 0xFF; ++n;
+                }
+            }
+            r /= n; g /= n; b /= n;
+            uPlane[(size_t)cy * cw + cx] = (Uint8)(128 + ((-38 * r - 74 * g + 112 * b + 128) >> 8));
+            vPlane[(size_t)cy * cw + cx] = (Uint8)(128 + ((112 * r - 94 * g - 18 * b + 128) >> 8));
+        }
+    }
+}
+
+bool writeY4mFrame(const std::vector<Uint8>& yuv) {
+    return std::fwrite("FRAME\n", 1, 6, sVideoFile) == 6 && std::fwrite(yuv.data(), 1, yuv.size(), sVideoFile) == yuv.size();
+}
+
+// The stream keeps its frame rate: a gap in the sequence repeats the last frame
+bool writeVideo(const CaptureBuffer& buffer, std::vector<Uint8>& yuv, SDL_Surface*& fullSize, Uint64& nextSequence) {
+    if (!yuv.empty()) {
+        for (; nextSequence < buffer.sequence; ++nextSequence, ++sRepeated) {
+            if (!writeY4mFrame(yuv)) return false;
+        }
+    }
+    const Uint8* pixels = buffer.pixels.data();
+    int pitch = CAPTURE_PITCH;
+    if (buffer.w != SCREEN_WIDTH || buffer.h != SCREEN_HEIGHT) { // Drawn at reduced resolution: upscale as the present did
+        if (!fullSize) fullSize = SDL_CreateRGBSurfaceWithFormat(0, SCREEN_WIDTH, SCREEN_HEIGHT, 32, SDL_PIXELFORMAT_ARGB8888);
+        SDL_Surface* scene = SDL_CreateRGBSurfaceWithFormatFrom((void*)buffer.pixels.data(), buffer.w, buffer.h, 32, CAPTURE_PITCH, SDL_PIXELFORMAT_ARGB8888);
+        bool ok = fullSize && scene && SDL_SoftStretchLinear(scene, nullptr, fullSize, nullptr) == 0;
+        if (scene) SDL_FreeSurface(scene);
+        if (!ok) return false;
+        pixels = static_cast<const Uint8*>(fullSize->pixels);
+        pitch = fullSize->pitch;
+    }
+    convertToI420(pixels, pitch, yuv);
+    nextSequence = buffer.sequence + 1;
+    return writeY4mFrame(yuv);
+}
+
+void writerLoop() {
+    std::vector<Uint8> yuv;           // Last video frame, kept for repeats
+    SDL_Surface* fullSize = nullptr;  // Upscale target for reduced-resolution frames
+    Uint64 nextSequence = 0;
+    for (;;) {
+        int index;
+        {
+            std::unique_lock<std::mutex> lock(sMutex);
+            sWake.wait(lock, [] { return sQueueCount > 0 || sStopping; });
+            if (sQueueCount == 0) break; // Stopping, and everything queued is written
+            index = sQueue[sQueueHead];
+            sQueueHead = (sQueueHead + 1) % CAPTURE_BUFFER_COUNT;
+            sQueueCount--;
+        }
+        const CaptureBuffer& buffer = sBuffers[index];
+        if (!sWriteFailed) {
+            bool ok = sVideo ? writeVideo(buffer, yuv, fullSize, nextSequence) : writePng(buffer);
+            if (ok) sWritten++;
+            else {
+                sWriteFailed = true; // Keep recycling buffers so the game side carries on unchanged
+                std::cerr << "ERROR: Frame capture could not write to " << sPath << ", capture stopped. SDL Error: " << SDL_GetError() << std::endl;
+            }
+        }
+        std::lock_guard<std::mutex> lock(sMutex);
+        sFree[sFreeCount++] = index;
+    }
+    // Whatever was on screen after the last capture (an idle menu, say) lasts to the stop
+    if (sVideo && !yuv.empty() && !sWriteFailed) {
+        for (; nextSequence < sEndSequence; ++nextSequence, ++sRepeated) {
+            if (!writeY4mFrame(yuv)) { sWriteFailed = true; break; }
+        }
+    }
+    if (fullSize) SDL_FreeSurface(fullSize);
+}
+
+} // namespace
+
+// --- Public Interface ---
+bool startFrameCapture(const std::string& path, int everyNth, int fps) {
+    stopFrameCapture();
+    sVideo = endsWith(path, ".y4m");
+    sPath = (!sVideo && endsWith(path, ".png")) ? path.substr(0, path.size() - 4) : path;
+    sEveryNth = std::max(1, everyNth);
+    sPerPresent = fps <= 0;
+    sFps = fps > 0 ? fps : PACER_DEFAULT_TARGET_FPS;
+    if (sVideo) {
+        sVideoFile = std::fopen(path.c_str(), "wb");
+        if (!sVideoFile) { std::cerr << "ERROR: Unable to open capture file " << path << "!" << std::endl; return false; }
+        std::fprintf(sVideoFile, "YUV4MPEG2 W%d H%d F%d:%d Ip A1:1 C420jpeg\n", SCREEN_WIDTH, SCREEN_HEIGHT, sFps, sEveryNth);
+    }
+
+    for (int i = 0; i < CAPTURE_BUFFER_COUNT; ++i) {
+        sBuffers[i].pixels.assign((size_t)CAPTURE_PITCH * SCREEN_HEIGHT, 0); // All up front: capturing never allocates
+        sFree[i] = i;
+    }
+    sFreeCount = CAPTURE_BUFFER_COUNT;
+    sQueueHead = sQueueCount = 0;
+    sStopping = false;
+    sEndSequence = sNextSequence = 0;
+    sStartCounter = SDL_GetPerformanceCounter();
+    sPresented = sCaptured = sDropped = sUnreadable = 0;
+    sReadbackMsSum = sReadbackMsMax = 0.0;
+    sWritten = sRepeated = 0;
+    sWriteFailed = false;
+
+    try {
+        sWriter = std::thread(writerLoop);
+    } catch (const std::system_error& e) {
+        std::cerr << "ERROR: Unable to start the capture writer (" << e.what() << ")." << std::endl;
+        if (sVideoFile) { std::fclose(sVideoFile); sVideoFile = nullptr; }
+        return false;
+    }
+    sActive = true;
+    std::cout << " -> Capturing " << (sVideo ? "Y4M video" : "a PNG sequence") << " to " << path;
+    if (sEveryNth > 1) std::cout << ", every " << sEveryNth << " frames";
+    std::cout << "." << std::endl;
+    return true;
+}
+
+void captureFrame(SDL_Renderer* renderer) {
+    if (!sActive) return;
+    sPresented++;
+    // The slot this present falls in: the video follows the wall clock whatever the
+    // present rate (vsync, uncapped, idle screens that skip presents)
+    Uint64 sequence = sPerPresent ? (sPresented - 1) / sEveryNth
+                                  : (Uint64)((double)(SDL_GetPerformanceCounter() - sStartCounter) / SDL_GetPerformanceFrequency() * sFps / sEveryNth);
+    if (sequence < sNextSequence) return; // Slot already has its frame
+    sNextSequence = sequence + 1;
+    int index = -1;
+    {
+        std::lock_guard<std::mutex> lock(sMutex);
+        if (sFreeCount > 0) index = sFree[--sFreeCount];
+    }
+    if (index < 0) { sDropped++; return; } // The writer is behind; never wait for it
+
+    CaptureBuffer& buffer = sBuffers[index];
+    Uint64 start = SDL_GetPerformanceCounter();
+    bool ok = readSceneFrame(renderer, buffer.pixels.data(), CAPTURE_PITCH, buffer.w, buffer.h);
+    double ms = (double)(SDL_GetPerformanceCounter() - start) * 1000.0 / SDL_GetPerformanceFrequency();
+    sReadbackMsSum += ms;
+    sReadbackMsMax = std::max(sReadbackMsMax, ms);
+
+    std::lock_guard<std::mutex> lock(sMutex);
+    if (!ok) { sUnreadable++; sFree[sFreeCount++] = index; return; }
+    buffer.sequence = sequence;
+    sQueue[(sQueueHead + sQueueCount) % CAPTURE_BUFFER_COUNT] = index;
+    sQueueCount++;
+    sCaptured++;
+    sWake.notify_one();
+}
+
+bool isFrameCaptureActive() { return sActive; }
+
+void stopFrameCapture() {
+    if (!sActive) return;
+    {
+        std::lock_guard<std::mutex> lock(sMutex);
+        sEndSequence = sPerPresent ? sNextSequence : (Uint64)((double)(SDL_GetPerformanceCounter() - sStartCounter) / SDL_GetPerformanceFrequency() * sFps / sEveryNth);
+        sStopping = true;
+    }
+    sWake.notify_one();
+    if (sWriter.joinable()) sWriter.join();
+    if (sVideoFile) { std::fclose(sVideoFile); sVideoFile = nullptr; }
+    for (auto& buffer : sBuffers) { buffer.pixels.clear(); buffer.pixels.shrink_to_fit(); }
+    sActive = false;
+}
+
+void reportFrameCapture() {
+    if (sPresented == 0) return;
+    stopFrameCapture(); // The writer's counts are final only after the join
+    std::string target = sVideo ? sPath : sPath + "_*.png";
+    char rate[48];
+    if (sPerPresent) std::snprintf(rate, sizeof(rate), "every %d captured", sEveryNth);
+    else std::snprintf(rate, sizeof(rate), "%.1f captured per second", (double)sFps / sEveryNth);
+    char line[320];
+    std::snprintf(line, sizeof(line), "Capture: %llu frames written to %s, %llu dropped (writer behind), %llu unreadable; %llu presented, %s; readback mean %.2f ms, max %.2f ms.",
+        (unsigned long long)sWritten, target.c_str(), (unsigned long long)sDropped, (unsigned long long)sUnreadable, (unsigned long long)sPresented, rate,
+        sCaptured + sUnreadable > 0 ? sReadbackMsSum / (double)(sCaptured + sUnreadable) : 0.0, sReadbackMsMax);
+    std::cout << line << std::endl;
+    if (sRepeated > 0) std::cout << "  " << sRepeated << " video frame(s) repeated over idle time or in place of dropped and unreadable ones." << std::endl;
+    if (sWriteFailed) std::cout << "  Writing failed; the capture is incomplete." << std::endl;
+}
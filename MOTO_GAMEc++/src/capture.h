@@ -0,0 +1,33 @@
+#ifndef CAPTURE_H
+#define CAPTURE_H
+
+#include <SDL.h>
+#include <string>
+
+// Frame Capture
+// --capture <path> records what is on screen at the frame rate (--fps; uncapped runs
+// use PACER_DEFAULT_TARGET_FPS), or at 1/N of it with --capture-every N, for bug
+// reports and visual checks next to benchmark runs:
+//   <name>.y4m  one YUV4MPEG2 stream (4:2:0, BT.601), SCREEN_WIDTH x SCREEN_HEIGHT
+//   otherwise   a PNG sequence, <path>_000000.png, <path>_000001.png, ...
+// Right after SDL_RenderPresent the finished scene (resolution.h) is read back into
+// one of CAPTURE_BUFFER_COUNT buffers allocated up front. A writer thread encodes
+// and writes it, then returns the buffer to the pool. The game thread never waits:
+// when every buffer is still queued, the frame is dropped and counted. The readback
+// runs after the render work is measured and before the pacer's wait, so dynamic
+// resolution does not react to it and the pacing slack absorbs it. Its cost is
+// still timed (profiler scope "capture") and reported. Frames are numbered by slot on
+// the wall clock since the start: a present takes a slot only if no earlier present
+// filled it, so faster (vsync) presents are skipped. Slots with no present (idle
+// screens, dropped frames) leave gaps in the PNG numbering; the video repeats the
+// previous frame through them, so it plays back in real time.
+
+// fps: slots per second before everyNth (Y4M header: fps / everyNth); <= 0 gives one
+// slot per presented frame, for offline renders such as frame_bench
+bool startFrameCapture(const std::string& path, int everyNth, int fps);
+void captureFrame(SDL_Renderer* renderer); // After SDL_RenderPresent
+bool isFrameCaptureActive();
+void stopFrameCapture();  // Writes out the queued frames and joins the writer
+void reportFrameCapture();
+
+#endif // CAPTURE_H
@@ -0,0 +1,103 @@
+#include <algorithm>
+#include <cstring>
+#include <istream>
+#include <ostream>
+
+#include "collision_mask.h"
+
+namespace {
+
+const char MASK_FILE_MAGIC[8] = { 'M', 'O', 'T', 'O', 'M', 'S', 'K', '1' };
+const int MASK_NAME_SIZE = 32;
+const int MASK_MAX_SIDE = 4096; // Sanity limit when reading
+
+// 64 bits of a row starting at bit 'start' (may be negative or past the end; those read as 0)
+inline std::uint64_t rowBits(const std::uint64_t* row, int words, int start) {
+    int word = start >= 0 ? start / 64 : -((63 - start) / 64); // Floor
+    int shift = start - word * 64;
+    std::uint64_t lo = (word >= 0 && word < words) ? row[word] : 0;
+    std::uint64_t hi = (word + 1 >= 0 && word + 1 < words) ? row[word + 1] : 0;
+    return shift ? (lo >> shift) | (hi << (64 - shift)) : lo;
+}
+
+} // namespace
+
+void buildCollisionMask(CollisionMask& mask, const std::uint8_t* alpha, int w, int h, int pitch, int stride, int threshold) {
+    mask.w = std::max(w, 0);
+    mask.h = std::max(h, 0);
+    mask.wordsPerRow = (mask.w + 63) / 64;
+    mask.bits.assign((size_t)mask.h * mask.wordsPerRow, 0);
+    mask.left = mask.w; mask.top = mask.h; mask.right = 0; mask.bottom = 0;
+    for (int y = 0; y < mask.h; ++y) {
+        const std::uint8_t* src = alpha + (size_t)y * pitch;
+        std::uint64_t* row = mask.bits.data() + (size_t)y * mask.wordsPerRow;
+        for (int x = 0; x < mask.w; ++x) {
+            if (src[(size_t)x * stride] < threshold) continue;
+            row[x / 64] |= std::uint64_t(1) << (x % 64);
+            mask.left = std::min(mask.left, x);
+            mask.right = std::max(mask.right, x + 1);
+            mask.top = std::min(mask.top, y);
+            mask.bottom = std::max(mask.bottom, y + 1);
+        }
+    }
+    if (mask.right <= mask.left) { mask.left = mask.top = mask.right = mask.bottom = 0; }
+}
+
+bool isMaskEmpty(const CollisionMask& mask) { return mask.right <= mask.left; }
+
+bool masksOverlap(const CollisionMask& a, int ax, int ay, const CollisionMask& b, int bx, int by) {
+    // Overlap of the opaque bounds, in a's coordinates
+    const int dx = bx - ax, dy = by - ay;
+    const int x0 = std::max(a.left, b.left + dx), x1 = std::min(a.right, b.right + dx);
+    const int y0 = std::max(a.top, b.top + dy), y1 = std::min(a.bottom, b.bottom + dy);
+    if (x0 >= x1 || y0 >= y1) return false;
+
+    // Bits outside the overlap are clear in one mask or the other, so whole words can be ANDed
+    const int firstWord = x0 / 64, lastWord = (x1 - 1) / 64;
+    for (int y = y0; y < y1; ++y) {
+        const std::uint64_t* rowA = a.bits.data() + (size_t)y * a.wordsPerRow;
+        const std::uint64_t* rowB = b.bits.data() + (size_t)(y - dy) * b.wordsPerRow;
+        for (int k = firstWord; k <= lastWord; ++k) {
+            if (rowA[k] & rowBits(rowB, b.wordsPerRow, k * 64 - dx)) return true;
+        }
+    }
+    return false;
+}
+
+bool writeAlphaPlanes(std::ostream& out, const std::vector<AlphaPlane>& planes) {
+    std::uint32_t count = (std::uint32_t)planes.size();
+    out.write(MASK_FILE_MAGIC, sizeof(MASK_FILE_MAGIC));
+    out.write((const char*)&count, sizeof(count));
+    for (const AlphaPlane& plane : planes) {
+        char name[MASK_NAME_SIZE] = {};
+        std::memcpy(name, plane.name.c_str(), std::min(plane.name.size(), sizeof(name) - 1));
+        if (plane.w < 0 || plane.h < 0 || (size_t)plane.w * plane.h != plane.alpha.size()) return false;
+        std::int32_t size[2] = { plane.w, plane.h };
+        out.write(name, sizeof(name));
+        out.write((const char*)size, sizeof(size));
+        out.write((const char*)plane.alpha.data(), (std::streamsize)plane.alpha.size());
+    }
+    return (bool)out;
+}
+
+bool readAlphaPlanes(std::istream& in, std::vector<AlphaPlane>& planes) {
+    char magic[sizeof(MASK_FILE_MAGIC)];
+    std::uint32_t count = 0;
+    if (!in.read(magic, sizeof(magic)) || std::memcmp(magic, MASK_FILE_MAGIC, sizeof(magic)) != 0) return false;
+    if (!in.read((char*)&count, sizeof(count))) return false;
+    planes.clear();
+    for (std::uint32_t i = 0; i < count; ++i) {
+        char name[MASK_NAME_SIZE];
+        std::int32_t size[2];
+        if (!in.read(name, sizeof(name)) || !in.read((char*)size, sizeof(size))) return false;
+        if (size[0] < 0 || size[1] < 0 || size[0] > MASK_MAX_SIDE || size[1] > MASK_MAX_SIDE) return false;
+        AlphaPlane plane;
+        plane.name.assign(name, std::find(name, name + sizeof(name), '\0'));
+        plane.w = size[0];
+        plane.h = size[1];
+        plane.alpha.resize((size_t)plane.w * plane.h);
+        if (!in.read((char*)plane.alpha.data(), (std::streamsize)plane.alpha.size())) return false;
+        planes.push_back(std::move(plane));
+    }
+    return true;
+}
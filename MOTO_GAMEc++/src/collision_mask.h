@@ -0,0 +1,49 @@
+#ifndef COLLISION_MASK_H
+#define COLLISION_MASK_H
+
+#include <cstdint>
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+// --- 1-Bit Collision Masks ---
+// One bit per pixel of a sprite at its drawn size, set where the alpha reaches
+// COLLISION_ALPHA_THRESHOLD. Rows are packed into 64-bit words, leftmost pixel in
+// the lowest bit; bits past the width stay zero. Two masks at whole-pixel positions
+// are tested row by row over their overlap only: the other mask's row is shifted
+// into alignment a word at a time and ANDed, so a 95-pixel player against a
+// 50-pixel barrier costs at most ~50 rows of 2-word ANDs. No SDL: the masks are
+// built from any alpha plane and used by the simulation (world.cpp).
+struct CollisionMask {
+    int w = 0;
+    int h = 0;
+    int wordsPerRow = 0;
+    std::vector<std::uint64_t> bits; // h * wordsPerRow
+    // Tight bounds of the set bits (empty mask: right <= left)
+    int left = 0, top = 0, right = 0, bottom = 0;
+};
+
+// alpha: w x h bytes, pitch bytes between rows, stride bytes between pixels
+void buildCollisionMask(CollisionMask& mask, const std::uint8_t* alpha, int w, int h, int pitch, int stride, int threshold);
+bool isMaskEmpty(const CollisionMask& mask);
+
+// Any pixel of a (top-left at ax, ay) over any pixel of b (at bx, by)
+bool masksOverlap(const CollisionMask& a, int ax, int ay, const CollisionMask& b, int bx, int by);
+
+// --- Alpha Plane Files ---
+// The SDL-free tools cannot decode or pre-scale the sprites, so tools/mask_builder.cpp
+// does it the way the game loader does and stores each sprite's alpha at its drawn
+// size; tools/batch_sim.cpp rebuilds the masks from them with buildCollisionMask().
+// Layout (little-endian): "MOTOMSK1" | uint32 count | count x { char name[32] |
+// int32 w | int32 h | w * h alpha bytes, row by row }
+struct AlphaPlane {
+    std::string name; // Sprite file stem, e.g. "barrier_01"
+    int w = 0;
+    int h = 0;
+    std::vector<std::uint8_t> alpha;
+};
+
+bool writeAlphaPlanes(std::ostream& out, const std::vector<AlphaPlane>& planes);
+bool readAlphaPlanes(std::istream& in, std::vector<AlphaPlane>& planes); // false: not a mask file or truncated
+
+#endif // COLLISION_MASK_H
@@ -23,6 +23,10 @@ const int BUTTON_Y_QUIT = 560;
 const int MENU_ANIM_FRAMES = 4;
 const float MENU_ANIM_SPEED = 0.25f;
 
+// Asset Loading Config
+const float LOADING_SCREEN_UPLOAD_BUDGET_MS = 12.0f; // Texture uploads per frame on the loading screen
+const float ASSET_UPLOAD_BUDGET_MS = 3.0f;           // ...and once the menu is interactive
+
 // Intro Config
 const int INTRO_SLIDE_COUNT = 4;
 const unsigned int SLIDE_DEFAULT_DURATION_MS = 22000; // Using unsigned int for SDL_Ticks consistency
@@ -31,19 +35,67 @@ const unsigned int SLIDE_DEFAULT_DURATION_MS = 22000; // Using unsigned int for
 const float PLAYER_VERT_SPEED = 300.0f;
 const float PLAYER_HORIZ_SPEED = 100.0f;
 const float PLAYER_HORIZ_MOVE_RANGE = 20.0f;
-const float BACKGROUND_SCROLL_SPEED = 200.0f;
+const float BACKGROUND_SCROLL_FACTOR = 0.5f; // Default far background speed relative to the road
+#define DEFAULT_PARALLAX_FILE "../assets/parallax/gameplay.layers"
 const int PLAYER_START_X = 100;
 const int BARRIER_WIDTH = 50;
 const int BARRIER_HEIGHT = 50;
 const float BARRIER_SPEED = 400.0f;
 const float BARRIER_SPAWN_INTERVAL = 2.0f;
 const int MAX_BARRIERS = 5;
+const int BARRIER_HITBOX_INSET = 6;        // Box fallback when the sprites have no collision masks
+const int COLLISION_ALPHA_THRESHOLD = 128; // Sprite pixels at least this opaque collide (collision_mask.h)
+const int MAX_COINS = 16;
+const int STRESS_DEFAULT_ENTITIES = 4096; // --stress without a count
 const int COIN_WIDTH = BARRIER_WIDTH / 2;
 const int COIN_HEIGHT = BARRIER_HEIGHT / 2;
 const float WIN_TIME = 40.0f;
 const float WIN_DELAY_TIME = 3.0f;
 const float COIN_SPAWN_INTERVAL = 1.5f;
+const float TRACK_MIN_SEGMENT_LENGTH = 200.0f; // Pixels of scroll; shorter segments fail validation
+#define DEFAULT_TRACK_FILE "../assets/tracks/default.track" // Override with --track
+
+
+// Drawn Sprite Sizes (images are pre-scaled to these at load, see AssetSize in assets.h)
+const float MENU_LOGO_LEFT_SCALE = 0.3f;   // logo_03
+const float MENU_LOGO_RIGHT_SCALE = 0.4f;  // logo_02
+const float ABOUT_LOGO_SCALE = 0.8f;       // logo_01
+const float SELECT_LOGO_SCALE = 0.25f;     // logo_05
+const int CHARACTER_CARD_WIDTH = 180;
+const int CHARACTER_CARD_HEIGHT = 220;
+const int DEFAULT_TEXTURE_BUDGET_MB = 0;   // 0 = unlimited; override with --texture-budget
+
+// Simulation Timing Config
+const int SIM_TICK_RATE = 120;           // Default fixed ticks per second (override with --tick-rate)
+const int SIM_MAX_TICKS_PER_FRAME = 8;   // Catch-up cap after a hitch
+const int IDLE_WAIT_TIMEOUT_MS = 250;     // Static screens: longest block in SDL_WaitEventTimeout
+
+// Frame Memory Config (see frame_arena.h, alloc_tracker.h)
+const int FRAME_ARENA_BYTES = 64 * 1024;     // Transient per-frame data; regrown if a frame needs more
+const int FRAME_ARENA_REGROW_WARNING = 4;    // Warn once the arena had to grow this often
+const int ALLOC_WARMUP_FRAMES = 60;          // PLAYING frames before the zero-allocation check applies
+const int REPLAY_STREAM_RESERVE_BYTES = 16 * 1024; // Run input stream capacity kept between runs
+
+// Input Latency Config (see latency.h)
+const int LATENCY_MAX_PENDING = 256;     // Inputs waiting for a frame to show them
+const int LATENCY_HISTOGRAM_MS = 250;    // 1 ms buckets; longer latencies share the last one
+
+// Dynamic Resolution Config (see resolution.h)
+const float DYNRES_MIN_SCALE = 0.5f;         // Also the floor for --res-scale
+const float DYNRES_SCALE_STEP = 0.1f;
+const double DYNRES_BUDGET_FRACTION = 0.8;   // Share of the frame period render work may take
+const double DYNRES_RAISE_HEADROOM = 0.85;   // Raise only if the predicted cost stays below this share of the budget
+const int DYNRES_COOLDOWN_FRAMES = 30;       // Frames to settle after a change
+
+// Frame Capture Config (see capture.h)
+const int CAPTURE_BUFFER_COUNT = 6; // Frames that can wait for the writer; further frames are dropped
 
+// Frame Pacing Config (used when vsync does not block, see pacer.h)
+const int PACER_DEFAULT_TARGET_FPS = 60;          // Override with --fps (0 = uncapped)
+const int PACER_PROBE_FRAMES = 60;                // Frames observed before deciding whether present blocks
+const double PACER_INITIAL_SPIN_MARGIN_MS = 2.0;  // Spin window before a deadline; adapts to SDL_Delay overshoot
+const double PACER_MIN_SPIN_MARGIN_MS = 0.5;
+const double PACER_MAX_SPIN_MARGIN_MS = 4.0;
 
 // Road Perspective Config
 const float ROAD_PERSPECTIVE_FAR_SCALE = 1.0f;
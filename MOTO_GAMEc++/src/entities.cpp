@@ -0,0 +1,162 @@
+#include <algorithm>
+#include <cmath>
+
+#include "entities.h"
+
+// --- Store Management ---
+void initEntityStore(EntityStore& store, int capacity) {
+    if (store.capacity != capacity) {
+        store.x.assign(capacity, 0.0f);
+        store.y.assign(capacity, 0.0f);
+        store.prevX.assign(capacity, 0.0f);
+        store.prevY.assign(capacity, 0.0f);
+        store.type.assign(capacity, 0);
+        store.hits.assign(capacity, 0);
+        store.capacity = capacity;
+    }
+    store.count = 0;
+}
+
+int spawnEntity(EntityStore& store, float x, float y, int type) {
+    if (store.count >= store.capacity) return -1;
+    int i = store.count++;
+    store.x[i] = x;
+    store.y[i] = y;
+    store.prevX[i] = x;
+    store.prevY[i] = y;
+    store.type[i] = type;
+    return i;
+}
+
+void removeEntity(EntityStore& store, int index) {
+    int last = --store.count;
+    if (index == last) return;
+    store.x[index] = store.x[last];
+    store.y[index] = store.y[last];
+    store.prevX[index] = store.prevX[last];
+    store.prevY[index] = store.prevY[last];
+    store.type[index] = store.type[last];
+}
+
+void copyEntityStore(EntityStore& dst, const EntityStore& src) {
+    initEntityStore(dst, src.capacity);
+    const int n = src.count;
+    std::copy_n(src.x.data(), n, dst.x.data());
+    std::copy_n(src.y.data(), n, dst.y.data());
+    std::copy_n(src.prevX.data(), n, dst.prevX.data());
+    std::copy_n(src.prevY.data(), n, dst.prevY.data());
+    std::copy_n(src.type.data(), n, dst.type.data());
+    dst.count = n;
+}
+
+// --- Kernels ---
+void storeEntityPositions(EntityStore& store) {
+    const int n = store.count;
+    const float* __restrict x = store.x.data();
+    const float* __restrict y = store.y.data();
+    float* __restrict px = store.prevX.data();
+    float* __restrict py = store.prevY.data();
+    for (int i = 0; i < n; ++i) { px[i] = x[i]; py[i] = y[i]; }
+}
+
+void moveEntities(EntityStore& store, float deltaX) {
+    const int n = store.count;
+    float* __restrict x = store.x.data();
+    for (int i = 0; i < n; ++i) x[i] += deltaX;
+}
+
+void cullEntitiesLeftOf(EntityStore& store, float minX, float entityWidth) {
+    // Walk backwards so a swapped-in entity has already been checked
+    for (int i = store.count - 1; i >= 0; --i) {
+        if (store.x[i] + entityWidth < minX) removeEntity(store, i);
+    }
+}
+
+int collideEntities(EntityStore& store, float playerX, float playerY, int playerSize, int entityW, int entityH, int inset) {
+    const int n = store.count;
+    const float* __restrict x = store.x.data();
+    const float* __restrict y = store.y.data();
+    int* __restrict hits = store.hits.data();
+
+    const float left = (float)(int)playerX, top = (float)(int)playerY;
+    const float right = left + playerSize, bottom = top + playerSize;
+    const float offset = (float)inset;
+    const float w = (float)(entityW - 2 * inset), h = (float)(entityH - 2 * inset);
+
+    int total = 0;
+    for (int i = 0; i < n; ++i) {
+        float ex = (float)(int)x[i] + offset;
+        float ey = (float)(int)y[i] + offset;
+        int hit = (ex < right) & (ex + w > left) & (ey < bottom) & (ey + h > top);
+        hits[i] = hit;
+        total += hit;
+    }
+    return total;
+}
+
+// Slab test per axis, in the player's frame: an entity edge starting at rel (relative to the
+// player's edge) and moving by v per tick overlaps while rel + v*t lies in (-entitySize, playerSize).
+// v is the same for every entity, so the still case is decided once, outside the loop.
+int sweepEntities(EntityStore& store, float entityDeltaX, const PlayerSweep& player, int entityW, int entityH, int inset, float maxTime, float& firstImpact) {
+    const int n = store.count;
+    const float* __restrict x = store.x.data();
+    const float* __restrict y = store.y.data();
+    int* __restrict hits = store.hits.data();
+
+    const float NEVER = 1e30f;
+    const float w = (float)(entityW - 2 * inset), h = (float)(entityH - 2 * inset);
+    const float size = (float)player.size;
+    const float vx = entityDeltaX - (player.toX - player.fromX); // Entities' y never changes
+    const float vy = -(player.toY - player.fromY);
+    const bool stillX = std::fabs(vx) < 1e-6f, stillY = std::fabs(vy) < 1e-6f;
+    const float invX = stillX ? 0.0f : 1.0f / vx, invY = stillY ? 0.0f : 1.0f / vy;
+    const float startX = -entityDeltaX + (float)inset - player.fromX; // Entity x at t = 0, relative to the player
+    const float startY = (float)inset - player.fromY;
+
+    int total = 0;
+    float first = 1.0f;
+    for (int i = 0; i < n; ++i) {
+        float rx = x[i] + startX;
+        float ry = y[i] + startY;
+        float ax = (-w - rx) * invX, bx = (size - rx) * invX;
+        float ay = (-h - ry) * invY, by = (size - ry) * invY;
+        bool insideX = rx > -w && rx < size, insideY = ry > -h && ry < size;
+        float enterX = stillX ? (insideX ? -NEVER : NEVER) : std::min(ax, bx);
+        float exitX = stillX ? (insideX ? NEVER : -NEVER) : std::max(ax, bx);
+        float enterY = stillY ? (insideY ? -NEVER : NEVER) : std::min(ay, by);
+        float exitY = stillY ? (insideY ? NEVER : -NEVER) : std::max(ay, by);
+        float enter = std::max(std::max(enterX, enterY), 0.0f);
+        float exit = std::min(std::min(exitX, exitY), 1.0f);
+        int hit = (enter < exit) & (enter < maxTime);
+        hits[i] = hit;
+        total += hit;
+        first = hit ? std::min(first, enter) : first;
+    }
+    firstImpact = first;
+    return total;
+}
+
+int refineSweepHits(EntityStore& store, float entityDeltaX, const PlayerSweep& player, const CollisionMask& playerMask, const CollisionMask* typeMasks, float maxTime, float& firstImpact) {
+    const float moveX = player.toX - player.fromX, moveY = player.toY - player.fromY;
+    const float relative = std::max(std::fabs(entityDeltaX - moveX), std::fabs(moveY));
+    const int steps = std::max(1, (int)std::ceil(relative));
+
+    int total = 0;
+    float first = 1.0f;
+    for (int i = 0; i < store.count; ++i) {
+        if (!store.hits[i]) continue;
+        const CollisionMask& mask = typeMasks[store.type[i]];
+        int hit = 0;
+        for (int s = 1; s <= steps && !hit; ++s) {
+            float t = (float)s / steps;
+            if (t > maxTime) break;
+            int px = (int)std::floor(player.fromX + moveX * t), py = (int)std::floor(player.fromY + moveY * t);
+            int ex = (int)std::floor(store.x[i] - entityDeltaX * (1.0f - t)), ey = (int)std::floor(store.y[i]);
+            if (masksOverlap(playerMask, px, py, mask, ex, ey)) { hit = 1; first = std::min(first, t); }
+        }
+        store.hits[i] = hit;
+        total += hit;
+    }
+    firstImpact = first;
+    return total;
+}
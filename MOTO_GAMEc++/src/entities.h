@@ -0,0 +1,56 @@
+#ifndef ENTITIES_H
+#define ENTITIES_H
+
+#include <vector>
+#include "collision_mask.h"
+
+// --- Structure-of-Arrays Entity Store ---
+// Barriers and coins live in packed parallel arrays. Active entities always occupy
+// [0, count): spawning appends, removal swaps the last entity into the hole, so the
+// per-tick kernels below run over one dense range with no 'active' checks and
+// compile to straight SIMD loops (SSE2 baseline, AVX with -mavx2).
+struct EntityStore {
+    std::vector<float> x;
+    std::vector<float> y;
+    std::vector<float> prevX; // Position at the previous tick (render interpolation)
+    std::vector<float> prevY;
+    std::vector<int> type;    // Barrier texture index; unused for coins
+    std::vector<int> hits;    // Scratch output of collideEntities()/sweepEntities()
+    int count = 0;
+    int capacity = 0;
+};
+
+void initEntityStore(EntityStore& store, int capacity); // Allocates once, then just clears
+int spawnEntity(EntityStore& store, float x, float y, int type); // Index, or -1 when full
+void removeEntity(EntityStore& store, int index);
+void copyEntityStore(EntityStore& dst, const EntityStore& src); // Live range only; reallocates only if capacities differ
+
+// Kernels
+void storeEntityPositions(EntityStore& store);
+void moveEntities(EntityStore& store, float deltaX);
+void cullEntitiesLeftOf(EntityStore& store, float minX, float entityWidth);
+// Flags store.hits[i] for every entity whose (inset) box overlaps the player box.
+// Boxes are truncated to whole pixels first, matching SDL_HasIntersection on SDL_Rects.
+int collideEntities(EntityStore& store, float playerX, float playerY, int playerSize, int entityW, int entityH, int inset);
+
+// Swept (continuous) collision over one tick. The player's box moves from (fromX, fromY)
+// to (toX, toY) while every entity moved by entityDeltaX to its current x, so contacts
+// between two ticks count no matter how far either side moved. Flags store.hits[i] for
+// entities whose (inset) box overlaps the player's at some time t in [0, maxTime), on
+// unrounded positions; touching edges do not count. Returns the number of hits and
+// stores the earliest time of impact (fraction of the tick, 0..1) in firstImpact.
+struct PlayerSweep {
+    float fromX, fromY;
+    float toX, toY;
+    int size;
+};
+int sweepEntities(EntityStore& store, float entityDeltaX, const PlayerSweep& player, int entityW, int entityH, int inset, float maxTime, float& firstImpact);
+
+// Narrow phase for the hits of sweepEntities() (run with inset 0, the sprite boxes):
+// each one is re-tested with pixel masks at whole-pixel positions, stepping through
+// (0, maxTime] at most one pixel of relative motion at a time. Hits whose masks never
+// touch are cleared. typeMasks is indexed by store.type. Returns the remaining hits
+// and the earliest touching step in firstImpact (1 when none).
+int refineSweepHits(EntityStore& store, float entityDeltaX, const PlayerSweep& player, const CollisionMask& playerMask, const CollisionMask* typeMasks, float maxTime, float& firstImpact);
+
+#endif // ENTITIES_H
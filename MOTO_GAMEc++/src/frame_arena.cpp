@@ -0,0 +1,116 @@
+#include <algorithm>
+#include <cstdarg>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <new>
+
+#include "config.h"
+#include "alloc_tracker.h"
+#include "frame_arena.h"
+
+// --- Arena Block and Spills ---
+namespace {
+
+// Heap blocks for the part of a frame that did not fit; freed at the reset
+struct SpillBlock {
+    SpillBlock* next;
+};
+
+unsigned char* sBlock = nullptr;
+size_t sCapacity = 0;
+size_t sUsed = 0;
+size_t sFrameBytes = 0;  // Requested this frame, including spills
+size_t sHighWater = 0;
+SpillBlock* sSpills = nullptr;
+int sRegrowths = 0;
+
+void* spill(size_t bytes, size_t align) {
+    size_t header = (sizeof(SpillBlock) + align - 1) / align * align;
+    SpillBlock* block = static_cast<SpillBlock*>(std::malloc(header + bytes));
+    if (!block) throw std::bad_alloc();
+    noteHeapAllocation(header + bytes); // The frame fell back to the heap: the zero-allocation check must see it
+    block->next = sSpills;
+    sSpills = block;
+    return reinterpret_cast<unsigned char*>(block) + header;
+}
+
+bool freeSpills() {
+    bool spilled = sSpills != nullptr;
+    while (sSpills) {
+        SpillBlock* next = sSpills->next;
+        std::free(sSpills);
+        sSpills = next;
+    }
+    return spilled;
+}
+
+} // namespace
+
+// --- Public Interface ---
+void* frameAlloc(size_t bytes, size_t align) {
+    if (!sBlock) {
+        sCapacity = FRAME_ARENA_BYTES;
+        sBlock = static_cast<unsigned char*>(std::malloc(sCapacity));
+        if (!sBlock) sCapacity = 0;
+        noteHeapAllocation(sCapacity);
+    }
+    bytes = std::max<size_t>(bytes, 1);
+    sFrameBytes += bytes + align - 1; // Worst-case padding, so the regrown block surely fits
+    uintptr_t base = reinterpret_cast<uintptr_t>(sBlock);
+    size_t offset = ((base + sUsed + align - 1) & ~(uintptr_t)(align - 1)) - base;
+    if (sBlock && offset + bytes <= sCapacity) {
+        sUsed = offset + bytes;
+        return sBlock + offset;
+    }
+    return spill(bytes, align);
+}
+
+std::string_view frameFormat(const char* format, ...) {
+    va_list args;
+    va_start(args, format);
+    va_list measure;
+    va_copy(measure, args);
+    int length = std::vsnprintf(nullptr, 0, format, measure);
+    va_end(measure);
+    if (length < 0) { va_end(args); return {}; }
+    char* text = static_cast<char*>(frameAlloc((size_t)length + 1, 1));
+    std::vsnprintf(text, (size_t)length + 1, format, args);
+    va_end(args);
+    return std::string_view(text, (size_t)length);
+}
+
+std::string_view frameString(std::string_view text) {
+    char* copy = static_cast<char*>(frameAlloc(text.size() + 1, 1));
+    std::memcpy(copy, text.data(), text.size());
+    copy[text.size()] = '\0';
+    return std::string_view(copy, text.size());
+}
+
+void resetFrameArena() {
+    sHighWater = std::max(sHighWater, sFrameBytes);
+    if (freeSpills()) { // Grow once to what this frame needed; later frames like it fit
+        std::free(sBlock);
+        sCapacity = std::max(sHighWater, sCapacity * 2);
+        sBlock = static_cast<unsigned char*>(std::malloc(sCapacity));
+        if (!sBlock) sCapacity = 0;
+        noteHeapAllocation(sCapacity);
+        sRegrowths++;
+        if (sRegrowths == FRAME_ARENA_REGROW_WARNING) std::cerr << "WARNING: Frame arena regrown " << sRegrowths << " times, now " << sCapacity / 1024 << " KB; raise FRAME_ARENA_BYTES." << std::endl;
+    }
+    sUsed = 0;
+    sFrameBytes = 0;
+}
+
+void closeFrameArena() {
+    freeSpills();
+    std::free(sBlock);
+    sBlock = nullptr;
+    sCapacity = 0;
+    sUsed = 0;
+    sFrameBytes = 0;
+}
+
+size_t getFrameArenaHighWater() { return std::max(sHighWater, sFrameBytes); }
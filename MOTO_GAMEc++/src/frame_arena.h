@@ -0,0 +1,41 @@
+#ifndef FRAME_ARENA_H
+#define FRAME_ARENA_H
+
+#include <cstddef>
+#include <string_view>
+#include <vector>
+
+// Per-Frame Arena
+// One linear block for data that only lives until the end of the current loop
+// iteration, such as formatted HUD strings and scratch lists. Allocating is a
+// pointer bump, nothing is freed individually, and resetFrameArena() rewinds the
+// whole block once per iteration. The block is allocated once (FRAME_ARENA_BYTES).
+// A frame that needs more spills to the heap, and the next reset regrows the block
+// to the high-water mark, so steady-state frames stay off the general heap
+// (alloc_tracker.h checks that). Main thread only; pointers into the arena must
+// not outlive the frame.
+
+void* frameAlloc(size_t bytes, size_t align = alignof(std::max_align_t));
+std::string_view frameFormat(const char* format, ...); // printf into the arena (NUL-terminated)
+std::string_view frameString(std::string_view text);   // NUL-terminated copy
+void resetFrameArena();  // Start of every main loop iteration
+void closeFrameArena();
+size_t getFrameArenaHighWater(); // Most bytes any frame has used
+
+// std:: containers on the arena; growth abandons the old buffer until the reset,
+// so reserve() up front
+template <typename T>
+struct FrameAllocator {
+    using value_type = T;
+    FrameAllocator() = default;
+    template <typename U> FrameAllocator(const FrameAllocator<U>&) {}
+    T* allocate(size_t n) { return static_cast<T*>(frameAlloc(n * sizeof(T), alignof(T))); }
+    void deallocate(T*, size_t) {}
+    template <typename U> bool operator==(const FrameAllocator<U>&) const { return true; }
+    template <typename U> bool operator!=(const FrameAllocator<U>&) const { return false; }
+};
+
+template <typename T>
+using FrameVector = std::vector<T, FrameAllocator<T>>;
+
+#endif // FRAME_ARENA_H
@@ -2,18 +2,23 @@
 #define FUNCTIONS_H
 
 #include <SDL.h>
-#include <SDL_ttf.h>
 #include <string>
-
-// Helper Functions
-SDL_Texture* loadTexture(const std::string& path, SDL_Renderer* renderer);
-bool renderText(const std::string& text, int x, int y, TTF_Font* font, SDL_Color color, SDL_Renderer* renderer);
+#include "world.h"
 
 // Core Game Functions
 bool initializeSDL();
 void resetGameState();
 bool loadMedia();
+bool loadTrack(const std::string& path); // false: keeps generated segments
+void renderLoadingBar(int x, int y, int w, int h);
 void closeSDL();
-void playCurrentIntroAudio();
+void enableStressMode(int entityCount);
+void storePreviousPositions();
+void updateGame(float deltaTime);
+void tickSession(World& world, float deltaTime); // PLAYING/WIN_DELAY tick incl. replay and ghost (any thread)
+void syncSimulation(); // Main thread, while the simulation thread runs
+void handleEvent(const SDL_Event& e, const SDL_Point& mousePoint);
+void renderGame(const SDL_Point& mousePoint, float renderAlpha);
+float lerpf(float from, float to, float t);
 
 #endif // FUNCTIONS_H
\ No newline at end of file
@@ -0,0 +1,626 @@
+#include <SDL.h>
+#include <SDL_ttf.h>
+#include <SDL_image.h>
+#include <SDL_mixer.h>
+#include <iostream>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+
+// Project-Specific Headers
+#include "config.h"    // Defines and consts
+#include "types.h"     // Enums and structs
+#include "globals.h"   // Extern global variable declarations
+#include "functions.h" // Function prototypes
+#include "text.h"      // Glyph-atlas text rendering
+#include "road.h"      // Baked perspective road
+#include "parallax.h"  // Cached parallax background layers
+#include "entities.h"  // SoA barrier/coin storage
+#include "assets.h"    // Threaded asset decoding
+#include "sprites.h"   // Sprite atlases and batching
+#include "intro.h"     // Streamed intro slides
+#include "audio.h"     // Streamed long sounds
+#include "archive.h"   // Memory-mapped asset archive
+#include "profiler.h"  // Frame timers and trace export
+#include "replay.h"    // Deterministic runs and the ghost rider
+#include "screen_cache.h" // Cached static screens / idle loop
+#include "track.h"     // Track segments and streaming
+#include "world.h"     // Gameplay simulation state
+#include "sim_thread.h" // PLAYING/WIN_DELAY on their own thread
+#include "resolution.h" // Offscreen scene target and fullscreen
+#include "latency.h"   // Input stamps and late latch
+#include "frame_arena.h" // Per-frame transient strings
+#include "alloc_tracker.h" // Steady-state allocation check
+#include "capture.h"   // Frame capture
+
+// --- Global Variable Definitions ---
+const char* const WINDOW_TITLE = "BROTHERHOOD"; // Definition
+
+SDL_Window* gWindow = nullptr;
+SDL_Renderer* gRenderer = nullptr;
+TTF_Font* gFont = nullptr;
+SDL_Color gTextColor = { 0, 0, 0, 255 };
+SDL_Color gAboutTextColor = { 255, 255, 255, 255 };
+SDL_Color gButtonHoverColor = { 255, 255, 0, 255 };
+SDL_Color gHeaderColor = {255, 200, 0, 255};
+int gSelectedCharacter = 0;
+
+SDL_Rect gPlayButtonRect = { BUTTON_X - 10, BUTTON_Y_PLAY - 10, BUTTON_WIDTH, BUTTON_HEIGHT };
+SDL_Rect gCharacterButtonRect = { BUTTON_X - 10, BUTTON_Y_CHARACTER - 10, BUTTON_WIDTH, BUTTON_HEIGHT };
+SDL_Rect gAboutButtonRect = { BUTTON_X - 10, BUTTON_Y_ABOUT - 10, BUTTON_WIDTH, BUTTON_HEIGHT };
+SDL_Rect gQuitButtonRect = { BUTTON_X - 10, BUTTON_Y_QUIT - 10, BUTTON_WIDTH, BUTTON_HEIGHT };
+int gCurrentMenuFrame = 0;
+float gMenuAnimTimer = 0.0f;
+Mix_Music* gMenuMusic = nullptr;
+
+std::vector<SDL_Texture*> gIntroSlides;
+SDL_Texture* gSkipButtonTexture = nullptr;
+SDL_Rect gSkipButtonRect; // Will be initialized in loadMedia
+int gCurrentIntroSlide = 0;
+unsigned int gIntroSlideStartTime = 0;
+
+SDL_Texture* gGameBgNearTexture = nullptr;
+SDL_Texture* gLoseScreenTexture = nullptr;
+SDL_Texture* gWinScreenTexture = nullptr;
+Mix_Music* gLoseSound = nullptr; // Streamed, see audio.h
+Mix_Music* gWinSound = nullptr;
+World gWorld;
+int gSimTickRate = SIM_TICK_RATE;
+bool gThreadedSimulation = true;
+int gMaxBarriers = MAX_BARRIERS;
+int gMaxCoins = MAX_COINS;
+float gBarrierSpawnInterval = BARRIER_SPAWN_INTERVAL;
+float gCoinSpawnInterval = COIN_SPAWN_INTERVAL;
+bool gStressMode = false;
+Track gTrack;
+
+GameState gCurrentState = GameState::LOADING;
+
+
+// --- Function Definitions ---
+
+// Initialization
+bool initializeSDL() {
+    std::cout << "Initializing SDL..." << std::endl;
+    if (SDL_Init(SDL_INIT_VIDEO | SDL_INIT_AUDIO) < 0) { std::cerr << "FATAL ERROR: SDL could not initialize! SDL_Error: " << SDL_GetError() << std::endl; return false; }
+    std::cout << " -> SDL Core Initialized." << std::endl;
+    if (TTF_Init() == -1) { std::cerr << "FATAL ERROR: SDL_ttf could not initialize! SDL_ttf Error: " << TTF_GetError() << std::endl; SDL_Quit(); return false; }
+     std::cout << " -> SDL_ttf Initialized." << std::endl;
+    int imgFlags = IMG_INIT_PNG;
+    if (!(IMG_Init(imgFlags) & imgFlags)) { std::cerr << "FATAL ERROR: SDL_image could not initialize! SDL_image Error: " << IMG_GetError() << std::endl; TTF_Quit(); SDL_Quit(); return false; }
+     std::cout << " -> SDL_image Initialized for PNG." << std::endl;
+    std::cout << "Initializing SDL_mixer..." << std::endl;
+    initAudioCodecs();
+    if (Mix_OpenAudio(AUDIO_FREQUENCY, AUDIO_SAMPLE_FORMAT, AUDIO_CHANNELS, 2048) < 0) { std::cerr << "FATAL ERROR: SDL_mixer could not initialize audio device! SDL_mixer Error: " << Mix_GetError() << std::endl; IMG_Quit(); TTF_Quit(); SDL_Quit(); return false; }
+     else { std::cout << " -> Audio device opened successfully (44100Hz, Stereo)." << std::endl; }
+    std::cout << "Creating Window..." << std::endl;
+    gWindow = SDL_CreateWindow(WINDOW_TITLE, SDL_WINDOWPOS_UNDEFINED, SDL_WINDOWPOS_UNDEFINED, SCREEN_WIDTH, SCREEN_HEIGHT, SDL_WINDOW_SHOWN | SDL_WINDOW_RESIZABLE);
+    if (gWindow == nullptr) { std::cerr << "FATAL ERROR: Window could not be created! SDL_Error: " << SDL_GetError() << std::endl; Mix_CloseAudio(); Mix_Quit(); IMG_Quit(); TTF_Quit(); SDL_Quit(); return false; }
+     std::cout << " -> Window created." << std::endl;
+    std::cout << "Creating Renderer..." << std::endl;
+    gRenderer = SDL_CreateRenderer(gWindow, -1, SDL_RENDERER_ACCELERATED | SDL_RENDERER_PRESENTVSYNC);
+    if (gRenderer == nullptr) { std::cerr << "FATAL ERROR: Renderer could not be created! SDL Error: " << SDL_GetError() << std::endl; SDL_DestroyWindow(gWindow); Mix_CloseAudio(); Mix_Quit(); IMG_Quit(); TTF_Quit(); SDL_Quit(); return false; }
+    SDL_SetRenderDrawColor(gRenderer, 0x22, 0x22, 0x22, 0xFF);
+     std::cout << " -> Renderer created." << std::endl;
+    std::cout << "All SDL Subsystems Initialized Successfully." << std::endl;
+    return true;
+}
+
+// Game State Reset
+void resetGameState() {
+    WorldRules rules;
+    rules.maxBarriers = gMaxBarriers;
+    rules.maxCoins = gMaxCoins;
+    rules.barrierSpacing = gBarrierSpawnInterval * BARRIER_SPEED;
+    rules.coinSpacing = gCoinSpawnInterval * BARRIER_SPEED;
+    rules.track = (gStressMode || gTrack.segments.empty()) ? nullptr : &gTrack;
+    rules.invulnerable = gStressMode;
+    // Pixel-accurate hits once the player and every barrier type have a mask
+    const CollisionMask* playerMask = getSpriteMask((gSelectedCharacter == 0) ? SpriteId::PLAYER_FEMALE : SpriteId::PLAYER_MALE);
+    if (playerMask && getSpriteMask(SpriteId::BARRIER_01) && getSpriteMask(SpriteId::BARRIER_02) && getSpriteMask(SpriteId::BARRIER_03)) {
+        rules.playerMask = playerMask;
+        rules.barrierMasks = getSpriteMask(SpriteId::BARRIER_01); // Barrier type n is BARRIER_01 + n
+    }
+    resetWorld(gWorld, rules);
+    beginRun(gWorld); // Seeds the world's RNG and places the ghost at the start
+}
+
+// Load Track (after loadMedia, so it can come from the archive)
+bool loadTrack(const std::string& path) {
+    std::string text;
+    Track track;
+    if (!readAssetText(path, text)) { std::cerr << "WARNING: Track file not found: " << path << ", using generated segments." << std::endl; return false; }
+    if (!parseTrack(text, path, track)) { std::cerr << "WARNING: Track '" << path << "' is invalid, using generated segments." << std::endl; return false; }
+    gTrack = std::move(track);
+    std::cout << " -> Track '" << gTrack.name << "': " << gTrack.segments.size() << " segments." << std::endl;
+    return true;
+}
+
+// Load Media
+bool loadMedia() {
+     std::cout << "Loading Media..." << std::endl;
+    openAssetArchive(); // Optional; every load below falls back to the loose file
+    // The font is needed right away for the loading screen
+    gFont = TTF_OpenFontRW(openAssetRW("../assets/fonts/game_font.ttf"), 1, 28);
+    if (gFont == nullptr) { std::cerr << "FATAL ERROR: Failed to load font! SDL_ttf Error: " << TTF_GetError() << std::endl; return false; }
+    if (!initTextRenderer(gFont, gRenderer)) { std::cerr << "WARNING: Glyph atlas unavailable, falling back to per-call text rendering." << std::endl; }
+
+    // Long sounds are streamed; opening one only reads its header
+    std::cout << " -> Opening Menu Music: " << resolveAudioPath("../assets/audio/music_menu") << std::endl;
+    gMenuMusic = openStream("../assets/audio/music_menu");
+    gLoseSound = openStream("../assets/audio/lose_audio");
+    gWinSound = openStream("../assets/audio/win_audio");
+
+    // Everything else decodes on the loader threads, menu assets first
+    for (int i = 0; i < MENU_ANIM_FRAMES; ++i) {
+        queueSpriteLoad((SpriteId)((int)SpriteId::MENU_BG_01 + i), "../assets/images/menu_anim/bg_frame_0" + std::to_string(i + 1) + ".png", AssetGroup::MENU, true);
+    }
+    queueSpriteLoad(SpriteId::LOGO_02, "../assets/images/logo_02.png", AssetGroup::MENU, false, scaledSize(MENU_LOGO_RIGHT_SCALE));
+    queueSpriteLoad(SpriteId::LOGO_03, "../assets/images/logo_03.png", AssetGroup::MENU, false, scaledSize(MENU_LOGO_LEFT_SCALE));
+    queueSpriteLoad(SpriteId::LOGO_04, "../assets/images/logo_04.png", AssetGroup::MENU);
+
+    queueSpriteLoad(SpriteId::LOGO_01, "../assets/images/logo_01.png", AssetGroup::ABOUT, false, scaledSize(ABOUT_LOGO_SCALE));
+
+    queueSpriteLoad(SpriteId::LOGO_05, "../assets/images/logo_05.png", AssetGroup::CHARACTER_SELECT, false, scaledSize(SELECT_LOGO_SCALE));
+    queueSpriteLoad(SpriteId::CHARACTER_01, "../assets/images/character_01.png", AssetGroup::CHARACTER_SELECT, false, exactSize(CHARACTER_CARD_WIDTH, CHARACTER_CARD_HEIGHT));
+    queueSpriteLoad(SpriteId::CHARACTER_02, "../assets/images/character_02.png", AssetGroup::CHARACTER_SELECT, false, exactSize(CHARACTER_CARD_WIDTH, CHARACTER_CARD_HEIGHT));
+
+    // Intro slides are loaded on demand, see intro.cpp
+    gIntroSlides.assign(INTRO_SLIDE_COUNT, nullptr);
+    queueTextureLoad("../assets/images/ui/skip_button.png", &gSkipButtonTexture, AssetGroup::INTRO, false, [](SDL_Texture* texture) {
+        int skipW, skipH; SDL_QueryTexture(texture, NULL, NULL, &skipW, &skipH);
+        gSkipButtonRect = { SCREEN_WIDTH - skipW - 20, SCREEN_HEIGHT - skipH - 20, skipW, skipH };
+    });
+
+    loadParallaxLayers(DEFAULT_PARALLAX_FILE, AssetGroup::GAMEPLAY);
+    queueTextureLoad("../assets/images/background_near.jpg", &gGameBgNearTexture, AssetGroup::GAMEPLAY, true, [](SDL_Texture* texture) {
+        if (!initRoadRenderer(texture, gRenderer)) { std::cerr << "WARNING: Road renderer could not be initialized!" << std::endl; }
+    });
+    queueSpriteLoad(SpriteId::BARRIER_01, "../assets/images/barrier_01.png", AssetGroup::GAMEPLAY, false, exactSize(BARRIER_WIDTH, BARRIER_HEIGHT), true);
+    queueSpriteLoad(SpriteId::BARRIER_02, "../assets/images/barrier_02.png", AssetGroup::GAMEPLAY, false, exactSize(BARRIER_WIDTH, BARRIER_HEIGHT), true);
+    queueSpriteLoad(SpriteId::BARRIER_03, "../assets/images/barrier_03.png", AssetGroup::GAMEPLAY, false, exactSize(BARRIER_WIDTH, BARRIER_HEIGHT), true);
+    queueSpriteLoad(SpriteId::COIN, "../assets/images/coins.png", AssetGroup::GAMEPLAY, false, exactSize(COIN_WIDTH, COIN_HEIGHT));
+    queueSpriteLoad(SpriteId::PLAYER_MALE, "../assets/images/select/player_male.png", AssetGroup::GAMEPLAY, false, exactSize(PLAYER_SQUARE_SIZE, PLAYER_SQUARE_SIZE), true);
+    queueSpriteLoad(SpriteId::PLAYER_FEMALE, "../assets/images/select/player_female.png", AssetGroup::GAMEPLAY, false, exactSize(PLAYER_SQUARE_SIZE, PLAYER_SQUARE_SIZE), true);
+    queueTextureLoad("../assets/images/endscreen/lose_slide.png", &gLoseScreenTexture, AssetGroup::GAMEPLAY, false, nullptr, exactSize(SCREEN_WIDTH, SCREEN_HEIGHT));
+    queueTextureLoad("../assets/images/endscreen/win_slide.png", &gWinScreenTexture, AssetGroup::GAMEPLAY, false, nullptr, exactSize(SCREEN_WIDTH, SCREEN_HEIGHT));
+
+    return startAssetLoading();
+}
+
+// Thin progress bar shown while assets are still decoding
+void renderLoadingBar(int x, int y, int w, int h) {
+    SDL_Rect bg = { x, y, w, h };
+    SDL_Rect fill = { x, y, (int)(w * getAssetLoadProgress()), h };
+    SDL_SetRenderDrawColor(gRenderer, 0, 0, 0, 255); SDL_RenderFillRect(gRenderer, &bg);
+    SDL_SetRenderDrawColor(gRenderer, 255, 215, 0, 255); SDL_RenderFillRect(gRenderer, &fill);
+    countDrawCalls(2);
+}
+
+// SDL Cleanup
+void closeSDL() {
+    stopSimulationThread(); // Quitting mid-run
+    stopFrameCapture();     // Writes out queued frames while SDL_image is still up
+    shutdownAssetLoader(); // Stop decoding before anything is freed
+    freeGroupTextures(); // Every startup texture and atlas page; owners are nulled
+    closeParallax();
+    closeRoadRenderer();
+    closeStaticScreenCache();
+    closeDynamicResolution();
+    closeSpriteSystem();
+    closeFrameArena();
+
+    endIntro(gRenderer); // Closes the narration stream if we quit mid-intro; needs gIntroSlides intact
+    for (auto& slide : gIntroSlides) if (slide) { SDL_DestroyTexture(slide); slide = nullptr; }
+    gIntroSlides.clear();
+
+    closeStream(gLoseSound);
+    closeStream(gWinSound);
+    closeStream(gMenuMusic);
+
+    closeTextRenderer();
+    if (gFont) { TTF_CloseFont(gFont); gFont = nullptr; }
+    closeAssetArchive(); // Last user of the mapping was the font
+    if (gRenderer) { SDL_DestroyRenderer(gRenderer); gRenderer = nullptr; }
+    if (gWindow) { SDL_DestroyWindow(gWindow); gWindow = nullptr; }
+    
+    Mix_CloseAudio(); Mix_Quit(); IMG_Quit(); TTF_Quit(); SDL_Quit();
+    std::cout << "SDL Cleanup Complete." << std::endl;
+}
+
+float lerpf(float from, float to, float t) { return from + (to - from) * t; }
+
+// Stress Mode: thousands of barriers/coins on screen, player cannot lose
+void enableStressMode(int entityCount) {
+    gStressMode = true;
+    gMaxBarriers = entityCount;
+    gMaxCoins = entityCount;
+    // Spawn just fast enough that the road holds entityCount of each at once
+    float crossingTime = (SCREEN_WIDTH + BARRIER_WIDTH) / BARRIER_SPEED;
+    gBarrierSpawnInterval = crossingTime / entityCount;
+    gCoinSpawnInterval = crossingTime / entityCount;
+    std::cout << " -> Stress mode: up to " << entityCount << " barriers and coins." << std::endl;
+}
+
+// Interpolation: remember where everything was before the next tick
+void storePreviousPositions() {
+    storeWorldPositions(gWorld);
+}
+
+// --- Sessions ---
+namespace {
+
+int sStressTicks = 0;
+double sStressTickSeconds = 0.0;
+Uint8 sHeldInput = 0; // Move keys down right now, as seen by this thread (late latch); cleared with the session
+
+// Mirrors the world's state on the main thread; the outcome sounds play here, never on the simulation thread
+void enterSessionState(GameState next) {
+    if (next == gCurrentState) return;
+    if (next == GameState::LOSE) playStream(gLoseSound);
+    else if (next == GameState::WIN) playStream(gWinSound);
+    if (!isSessionState(next)) sHeldInput = 0; // Releases after the run are not routed here
+    gCurrentState = next;
+}
+
+void setMoveInput(Uint8 inputBits, bool pressed) {
+    if (pressed) sHeldInput |= inputBits;
+    else sHeldInput &= (Uint8)~inputBits;
+    if (isSimulationThreadRunning()) {
+        Uint64 stamp = getLatestInputStamp(); // The event being handled
+        sendSimulationInput(inputBits, pressed, stamp);
+        markInputRouted(stamp);
+        return;
+    }
+    if (pressed) gWorld.input |= inputBits;
+    else gWorld.input &= (Uint8)~inputBits;
+}
+
+// ESC during a run
+void abandonSession() {
+    stopSimulationThread();
+    sHeldInput = 0;
+    if (finishRun(GameState::MENU, gWorld)) { gCurrentState = GameState::EXIT; return; } // Replay playback ends here
+    gCurrentState = GameState::MENU;
+    playMenuMusic();
+}
+
+} // namespace
+
+// One PLAYING/WIN_DELAY tick, on whichever thread owns the world
+void tickSession(World& world, float deltaTime) {
+    Uint64 tickStart = gStressMode ? SDL_GetPerformanceCounter() : 0;
+    bool playing = world.state == GameState::PLAYING;
+    if (playing) world.input = applyRunInput(world.input); // Replays substitute the recorded bits
+    stepWorld(world, deltaTime);
+    if (playing) {
+        stepGhost(deltaTime);
+        if (world.state != GameState::PLAYING && finishRun(world.state, world)) { world.state = GameState::EXIT; } // Checksum covers the whole final tick
+    }
+    if (gStressMode && playing) {
+        sStressTickSeconds += (double)(SDL_GetPerformanceCounter() - tickStart) / SDL_GetPerformanceFrequency();
+        if (++sStressTicks == gSimTickRate * 2) {
+            std::cout << "[stress] barriers=" << world.barriers.count << " coins=" << world.coins.count << " avg tick=" << (sStressTickSeconds / sStressTicks) * 1e6 << " us" << std::endl;
+            sStressTicks = 0; sStressTickSeconds = 0.0;
+        }
+    }
+}
+
+// Main thread: adopt the newest snapshot's state, join the thread once the session is over
+void syncSimulation() {
+    const SimSnapshot& snapshot = acquireSimSnapshot();
+    if (isSessionState(snapshot.world.state)) { enterSessionState(snapshot.world.state); return; }
+    stopSimulationThread(); // gWorld belongs to this thread again
+    enterSessionState(gWorld.state);
+}
+
+// Fixed-Tick Update: advances every state by exactly one simulation step
+void updateGame(float deltaTime) {
+    switch(gCurrentState) {
+        case GameState::LOADING: {
+            if (isReplayPlayback()) {
+                if (isAssetGroupReady(AssetGroup::GAMEPLAY)) { gCurrentState = GameState::PLAYING; resetGameState(); } // Straight into the run
+            } else if (isAssetGroupReady(AssetGroup::MENU)) {
+                gCurrentState = GameState::MENU;
+                playMenuMusic();
+            }
+        } break;
+        case GameState::MENU: {
+            gMenuAnimTimer += deltaTime;
+            if (gMenuAnimTimer >= MENU_ANIM_SPEED) { gMenuAnimTimer -= MENU_ANIM_SPEED; gCurrentMenuFrame = (gCurrentMenuFrame + 1) % MENU_ANIM_FRAMES; }
+        } break;
+        case GameState::INTRO: {
+             bool advanceSlide = isIntroNarrationFinished();
+             unsigned int timeElapsed = SDL_GetTicks() - gIntroSlideStartTime; // Use unsigned int
+             if (!advanceSlide && timeElapsed > SLIDE_DEFAULT_DURATION_MS) { advanceSlide = true; } // advanceIntroSlide stops the narration
+             if (advanceSlide && !advanceIntroSlide(gRenderer)) {
+                  gCurrentState = GameState::PLAYING;
+                  resetGameState();
+             }
+        } break;
+        case GameState::ABOUT: { /* No updates */ } break;
+        case GameState::PLAYING:
+        case GameState::WIN_DELAY: {
+            tickSession(gWorld, deltaTime);
+            enterSessionState(gWorld.state);
+        } break;
+        default: break;
+    }
+}
+
+// Input: one event against the current state
+void handleEvent(const SDL_Event& e, const SDL_Point& mousePoint) {
+    if (e.type == SDL_QUIT) {
+        stopStream();
+        gCurrentState = GameState::EXIT;
+        return;
+    }
+    if (e.type == SDL_RENDER_TARGETS_RESET || e.type == SDL_RENDER_DEVICE_RESET) { invalidateRoadCache(); invalidateParallaxCache(); invalidateStaticScreen(); return; }
+    if (e.type == SDL_WINDOWEVENT) { invalidateStaticScreen(); return; } // Exposed/restored: the window needs a fresh present
+    if (e.type == SDL_KEYDOWN && e.key.repeat == 0 && e.key.keysym.sym == SDLK_F3) { toggleProfilerOverlay(); invalidateStaticScreen(); return; }
+    if (e.type == SDL_KEYDOWN && e.key.repeat == 0 && e.key.keysym.sym == SDLK_F4) { excuseAllocationFrame(); writeProfilerTrace("profile_trace.json"); return; }
+    if (e.type == SDL_KEYDOWN && e.key.repeat == 0 && e.key.keysym.sym == SDLK_F11) { toggleFullscreen(gWindow); return; }
+
+    switch(gCurrentState) {
+        case GameState::MENU: {
+            if (e.type == SDL_MOUSEBUTTONDOWN && e.button.button == SDL_BUTTON_LEFT) {
+                if (SDL_PointInRect(&mousePoint, &gPlayButtonRect)) {
+                    waitForAssetGroup(AssetGroup::INTRO, gRenderer);
+                    waitForAssetGroup(AssetGroup::GAMEPLAY, gRenderer);
+                    stopStream();
+                    gCurrentState = GameState::INTRO; beginIntro(gRenderer);
+                } else if (SDL_PointInRect(&mousePoint, &gCharacterButtonRect)) {
+                    waitForAssetGroup(AssetGroup::CHARACTER_SELECT, gRenderer);
+                    gCurrentState = GameState::CHARACTER_SELECT;
+                } else if (SDL_PointInRect(&mousePoint, &gAboutButtonRect)) {
+                    waitForAssetGroup(AssetGroup::ABOUT, gRenderer);
+                    gCurrentState = GameState::ABOUT;
+                } else if (SDL_PointInRect(&mousePoint, &gQuitButtonRect)) {
+                    stopStream(); gCurrentState = GameState::EXIT;
+                }
+            }
+        } break;
+
+        case GameState::INTRO: {
+            bool skipTriggered = false;
+            if (e.type == SDL_MOUSEBUTTONDOWN && e.button.button == SDL_BUTTON_LEFT) { if (gSkipButtonTexture != nullptr && SDL_PointInRect(&mousePoint, &gSkipButtonRect)) { skipTriggered = true; } }
+            else if (e.type == SDL_KEYDOWN && e.key.keysym.sym == SDLK_RETURN && e.key.repeat == 0) { skipTriggered = true; }
+            if (skipTriggered && !advanceIntroSlide(gRenderer)) {
+                gCurrentState = GameState::PLAYING;
+                resetGameState();
+            }
+        } break;
+
+        case GameState::ABOUT: {
+            if ((e.type == SDL_MOUSEBUTTONDOWN && e.button.button == SDL_BUTTON_LEFT) || (e.type == SDL_KEYDOWN && e.key.repeat == 0)) {
+                 gCurrentState = GameState::MENU; playMenuMusic();
+            }
+        } break;
+
+        case GameState::PLAYING: {
+            if (e.type == SDL_KEYDOWN && e.key.repeat == 0) {
+                 switch(e.key.keysym.sym) {
+                    case SDLK_UP: setMoveInput(INPUT_UP, true); break;
+                    case SDLK_DOWN: setMoveInput(INPUT_DOWN, true); break;
+                    case SDLK_LEFT: setMoveInput(INPUT_LEFT, true); break;
+                    case SDLK_RIGHT: setMoveInput(INPUT_RIGHT, true); break;
+                    case SDLK_ESCAPE: abandonSession(); break;
+                    default: break;
+                 }
+            } else if (e.type == SDL_KEYUP && e.key.repeat == 0) {
+                  switch(e.key.keysym.sym) {
+                    case SDLK_UP: setMoveInput(INPUT_UP, false); break;
+                    case SDLK_DOWN: setMoveInput(INPUT_DOWN, false); break;
+                    case SDLK_LEFT: setMoveInput(INPUT_LEFT, false); break;
+                    case SDLK_RIGHT: setMoveInput(INPUT_RIGHT, false); break;
+                    default: break;
+                  }
+             }
+        } break;
+
+        case GameState::LOSE:
+        case GameState::WIN: {
+            if (e.type == SDL_MOUSEBUTTONDOWN || (e.type == SDL_KEYDOWN && e.key.repeat == 0)) {
+                gCurrentState = GameState::MENU;
+                playMenuMusic();
+            }
+        } break;
+
+        case GameState::CHARACTER_SELECT: {
+            if (e.type == SDL_KEYDOWN && e.key.repeat == 0) {
+                if (e.key.keysym.sym == SDLK_LEFT) { gSelectedCharacter = 0; invalidateStaticScreen(); }
+                else if (e.key.keysym.sym == SDLK_RIGHT) { gSelectedCharacter = 1; invalidateStaticScreen(); }
+                else if (e.key.keysym.sym == SDLK_RETURN || e.key.keysym.sym == SDLK_ESCAPE) {
+                    gCurrentState = GameState::MENU;
+                }
+            }
+        } break;
+        default: break;
+    }
+}
+
+// Render: draws the current state (no present)
+// --- Texture Residency ---
+namespace {
+
+// The asset groups each screen draws from; anything else may be evicted under the budget
+void useScreenAssets(GameState state) {
+    switch (state) {
+        case GameState::MENU: useAssetGroups({ AssetGroup::MENU }, gRenderer); break;
+        case GameState::INTRO: useAssetGroups({ AssetGroup::INTRO }, gRenderer); break;
+        case GameState::ABOUT: useAssetGroups({ AssetGroup::ABOUT }, gRenderer); break;
+        case GameState::CHARACTER_SELECT: useAssetGroups({ AssetGroup::CHARACTER_SELECT }, gRenderer); break;
+        case GameState::PLAYING:
+        case GameState::WIN_DELAY:
+        case GameState::LOSE:
+        case GameState::WIN: useAssetGroups({ AssetGroup::GAMEPLAY }, gRenderer); break;
+        default: useAssetGroups({}, gRenderer); break;
+    }
+}
+
+} // namespace
+
+void renderGame(const SDL_Point& mousePoint, float renderAlpha) {
+    PROFILE_SCOPE("render");
+    useScreenAssets(gCurrentState); // Before the static-screen cache check, so cached screens count as in use
+    bool staticScreen = isStaticScreenState(gCurrentState);
+    if (!staticScreen) { invalidateStaticScreen(); } // Re-entering a static screen always recomposes it
+    else if (beginStaticScreen(gRenderer, gCurrentState)) { renderProfilerOverlay(gRenderer, gFont); return; }
+    SDL_SetRenderDrawColor(gRenderer, 0x00, 0x00, 0x00, 0xFF); 
+    SDL_RenderClear(gRenderer);
+
+    switch(gCurrentState) {
+        case GameState::LOADING: {
+            SDL_SetRenderDrawColor(gRenderer, 0x22, 0x22, 0x22, 0xFF); SDL_RenderClear(gRenderer);
+            renderText("LOADING...", SCREEN_WIDTH / 2 - 80, SCREEN_HEIGHT / 2 - 50, gFont, gAboutTextColor, gRenderer);
+            renderLoadingBar(SCREEN_WIDTH / 4, SCREEN_HEIGHT / 2, SCREEN_WIDTH / 2, 18);
+        } break;
+
+        case GameState::MENU: {
+            SpriteId menuFrame = (SpriteId)((int)SpriteId::MENU_BG_01 + gCurrentMenuFrame);
+            if (hasSprite(menuFrame)) {
+                drawSprite(menuFrame, { 0, 0, SCREEN_WIDTH, SCREEN_HEIGHT }, LAYER_BACKGROUND);
+            } else { SDL_SetRenderDrawColor(gRenderer, 0x22, 0x22, 0x22, 0xFF); SDL_RenderClear(gRenderer); }
+            if (hasSprite(SpriteId::LOGO_03)) { SDL_Point sz = getSpriteSize(SpriteId::LOGO_03); drawSprite(SpriteId::LOGO_03, {20,20,sz.x,sz.y}, LAYER_OVERLAY); }
+            if (hasSprite(SpriteId::LOGO_02)) { SDL_Point sz = getSpriteSize(SpriteId::LOGO_02); drawSprite(SpriteId::LOGO_02, {SCREEN_WIDTH-sz.x-20, 20, sz.x, sz.y}, LAYER_OVERLAY); }
+            flushSprites(gRenderer);
+            renderText("PLAY", BUTTON_X, BUTTON_Y_PLAY, gFont, SDL_PointInRect(&mousePoint, &gPlayButtonRect) ? gButtonHoverColor : gTextColor, gRenderer);
+            renderText("CHARACTER", BUTTON_X, BUTTON_Y_CHARACTER, gFont, SDL_PointInRect(&mousePoint, &gCharacterButtonRect) ? gButtonHoverColor : gTextColor, gRenderer);
+            renderText("ABOUT", BUTTON_X, BUTTON_Y_ABOUT, gFont, SDL_PointInRect(&mousePoint, &gAboutButtonRect) ? gButtonHoverColor : gTextColor, gRenderer);
+            renderText("QUIT", BUTTON_X, BUTTON_Y_QUIT, gFont, SDL_PointInRect(&mousePoint, &gQuitButtonRect) ? gButtonHoverColor : gTextColor, gRenderer);
+            if (!isAssetLoadingComplete()) { renderLoadingBar(0, SCREEN_HEIGHT - 6, SCREEN_WIDTH, 6); }
+        } break;
+    
+        case GameState::INTRO: {
+             if (gCurrentIntroSlide < gIntroSlides.size() && gIntroSlides[gCurrentIntroSlide] != nullptr) { SDL_RenderCopy(gRenderer, gIntroSlides[gCurrentIntroSlide], nullptr, nullptr); countDrawCalls(); }
+              else { SDL_SetRenderDrawColor(gRenderer, 0x11,0x11,0x11,0xFF); SDL_RenderClear(gRenderer); renderText("Missing Intro Slide!",100,100,gFont,gTextColor,gRenderer); }
+             if (gSkipButtonTexture != nullptr) { SDL_RenderCopy(gRenderer, gSkipButtonTexture, nullptr, &gSkipButtonRect); countDrawCalls(); }
+        } break;
+    
+        case GameState::ABOUT: {
+            SDL_SetRenderDrawColor(gRenderer, 0x11, 0x11, 0x25, 0xFF); SDL_RenderClear(gRenderer);
+            int y=50, ls=30, ss=45, tx=50, rsX=SCREEN_WIDTH-400;
+            renderText("The Story",tx,y,gFont,gHeaderColor,gRenderer); y+=ls;
+            renderText("In a world craving speed, you are a daring rider",tx,y,gFont,gAboutTextColor,gRenderer); y+=ls;
+            renderText("competing in the legendary Moto Rush challenge.",tx,y,gFont,gAboutTextColor,gRenderer); y+=ls;
+            renderText("Only the fastest will reach the finish line.",tx,y,gFont,gAboutTextColor,gRenderer); y+=ls+ss;
+            renderText("Your Goal",tx,y,gFont,gHeaderColor,gRenderer); y+=ls;
+            renderText("Reach the final destination point",tx,y,gFont,gAboutTextColor,gRenderer); y+=ls;
+            renderText("before the timer runs out!",tx,y,gFont,gAboutTextColor,gRenderer); y+=ls+ss;
+            renderText("Rules",tx,y,gFont,gHeaderColor,gRenderer); y+=ls;
+            renderText("- You have only 40 seconds to complete the race.",tx,y,gFont,gAboutTextColor,gRenderer); y+=ls;
+            renderText("- If the timer hits zero before you finish, you lose.",tx,y,gFont,gAboutTextColor,gRenderer); y+=ls;
+            renderText("- Avoid obstacles.",tx,y,gFont,gAboutTextColor,gRenderer); y+=ls+ss;
+            renderText("Controls",tx,y,gFont,gHeaderColor,gRenderer); y+=ls;
+            renderText("- Left/Right Arrows: Select character (selection screen)",tx,y,gFont,gAboutTextColor,gRenderer); y+=ls;
+            renderText("- Enter: Confirm selection / Start game",tx,y,gFont,gAboutTextColor,gRenderer); y+=ls;
+            renderText("- Left/Right Arrows (Game): Move Horizontally (Slightly)",tx,y,gFont,gAboutTextColor,gRenderer); y+=ls; 
+            renderText("- Up/Down Arrows (Game): Move Vertically",tx,y,gFont,gAboutTextColor,gRenderer); y+=ls;
+            renderText("- ESC (Game): Return to Main Menu",tx,y,gFont,gAboutTextColor,gRenderer);
+            if(hasSprite(SpriteId::LOGO_01)){SDL_Point sz=getSpriteSize(SpriteId::LOGO_01);int sw=sz.x,sh=sz.y;drawSprite(SpriteId::LOGO_01,{rsX+(400-sw)/2,(SCREEN_HEIGHT-sh)/2,sw,sh},LAYER_OVERLAY);}
+            flushSprites(gRenderer);
+        } break;
+    
+        case GameState::PLAYING:
+        case GameState::WIN_DELAY: 
+        {
+            // Newest simulation-thread snapshot, or gWorld when the session ticks on this thread
+            const World* view = &gWorld;
+            GhostPose ghost;
+            if (isSimulationThreadRunning()) {
+                const SimSnapshot& snapshot = acquireSimSnapshot();
+                view = &snapshot.world;
+                ghost = snapshot.ghost;
+                renderAlpha = getSnapshotAlpha(snapshot);
+                markInputsVisible(snapshot.inputStamp);
+            } else { ghost = getGhostPose(); }
+            const World& world = *view;
+
+            // 1. Render Parallax Background (layers from gameplay.layers, cached per scroll speed)
+            {
+                PROFILE_SCOPE("parallax");
+                renderParallax(gRenderer, lerpf(world.prevScrollDistance, world.scrollDistance, renderAlpha));
+            }
+
+            // 2. Render Road with Static Perspective (baked once, see road.cpp)
+            {
+                PROFILE_SCOPE("road");
+                countDrawCalls(renderRoad(gRenderer));
+            }
+
+            // 3. Render Timer Bar
+            int barMaxWidth=SCREEN_WIDTH/4, barH=18, barX=20, barY=15; float timeLeft=std::max(0.0f,WIN_TIME-world.gameTimer); int barW=(int)(barMaxWidth*(timeLeft/WIN_TIME));
+            drawRectBatched({barX,barY,barMaxWidth,barH}, {0,0,0,255}, LAYER_HUD_BACK);
+            drawRectBatched({barX,barY,barW,barH}, {255,215,0,255}, LAYER_HUD_BACK);
+
+            // 4. Render Barriers and Coins (one atlas, one batch)
+            for (int i = 0; i < world.barriers.count; ++i) {
+                SDL_Rect br={(int)lerpf(world.barriers.prevX[i],world.barriers.x[i],renderAlpha),(int)lerpf(world.barriers.prevY[i],world.barriers.y[i],renderAlpha),BARRIER_WIDTH,BARRIER_HEIGHT};
+                SpriteId sprite = (SpriteId)((int)SpriteId::BARRIER_01 + world.barriers.type[i]);
+                if (hasSprite(sprite)) drawSprite(sprite, br, LAYER_ENTITIES); else drawRectBatched(br, {255,0,0,255}, LAYER_ENTITIES);
+            }
+            for (int i = 0; i < world.coins.count; ++i) {
+                SDL_Rect cr={(int)lerpf(world.coins.prevX[i],world.coins.x[i],renderAlpha),(int)lerpf(world.coins.prevY[i],world.coins.y[i],renderAlpha),COIN_WIDTH,COIN_HEIGHT};
+                if (hasSprite(SpriteId::COIN)) drawSprite(SpriteId::COIN, cr, LAYER_ENTITIES); else drawRectBatched(cr, {255,215,0,255}, LAYER_ENTITIES);
+            }
+
+            // 5. Render Ghost (best run) and Player
+            if (ghost.visible) {
+                SDL_Rect ghostR = {(int)lerpf(ghost.prevX,ghost.x,renderAlpha),(int)lerpf(ghost.prevY,ghost.y,renderAlpha),PLAYER_SQUARE_SIZE,PLAYER_SQUARE_SIZE};
+                drawSprite((ghost.character==0) ? SpriteId::PLAYER_FEMALE : SpriteId::PLAYER_MALE, ghostR, LAYER_PLAYER, {160,200,255,110});
+            }
+            SDL_Rect playerR = {(int)lerpf(world.prevPlayerX,world.playerX,renderAlpha),(int)lerpf(world.prevPlayerY,world.playerY,renderAlpha),PLAYER_SQUARE_SIZE,PLAYER_SQUARE_SIZE};
+            if (isLateLatchEnabled() && world.state == GameState::PLAYING && !isReplayPlayback()) {
+                // Late latch: the interpolated pose with the motion the last tick simulated over
+                // the interpolated span (lerp - prev) swapped for the motion of the keys held
+                // right now. That leaves the previous pose stepped by the held keys for the same
+                // span barriers and coins are interpolated over, so the player stays in step.
+                float px = world.prevPlayerX, py = world.prevPlayerY;
+                stepPlayer(px, py, sHeldInput, renderAlpha / gSimTickRate);
+                playerR.x = (int)px; playerR.y = (int)py;
+                markInputsVisible(getLatestInputStamp());
+            }
+            SpriteId playerSprite = (gSelectedCharacter==0) ? SpriteId::PLAYER_FEMALE : SpriteId::PLAYER_MALE;
+            if (hasSprite(playerSprite)) drawSprite(playerSprite, playerR, LAYER_PLAYER); else drawRectBatched(playerR, {255,0,0,255}, LAYER_PLAYER);
+            flushSprites(gRenderer);
+
+            // 6. Render Coin Counter
+            renderDynamicText(frameFormat("%d", world.coinCounter),SCREEN_WIDTH-150,20,gFont,gTextColor,gRenderer);
+
+            if (gCurrentState == GameState::WIN_DELAY) {
+                renderText("YOU WIN!", SCREEN_WIDTH / 2 - 100, SCREEN_HEIGHT / 2 - 50, gFont, gHeaderColor, gRenderer);
+            }
+        } break;
+
+        case GameState::LOSE: {
+            if (gLoseScreenTexture) { SDL_RenderCopy(gRenderer, gLoseScreenTexture, nullptr, nullptr); countDrawCalls(); }
+            else { SDL_SetRenderDrawColor(gRenderer,0x11,0x11,0x11,0xFF); SDL_RenderClear(gRenderer); renderText("GAME OVER!",SCREEN_WIDTH/2-100,SCREEN_HEIGHT/2-50,gFont,gTextColor,gRenderer); renderText("Click to return",SCREEN_WIDTH/2-100,SCREEN_HEIGHT/2+20,gFont,gTextColor,gRenderer); }
+        } break;
+
+        case GameState::WIN: {
+            if (gWinScreenTexture) { SDL_RenderCopy(gRenderer, gWinScreenTexture, nullptr, nullptr); countDrawCalls(); }
+            else { SDL_SetRenderDrawColor(gRenderer,0x11,0x11,0x11,0xFF); SDL_RenderClear(gRenderer); renderText("YOU WIN!",SCREEN_WIDTH/2-100,SCREEN_HEIGHT/2-50,gFont,gTextColor,gRenderer); renderText("Click to return",SCREEN_WIDTH/2-100,SCREEN_HEIGHT/2+20,gFont,gTextColor,gRenderer); }
+        } break;
+
+        case GameState::CHARACTER_SELECT: {
+            SDL_SetRenderDrawColor(gRenderer, 20, 30, 60, 255); SDL_RenderClear(gRenderer);
+            if (hasSprite(SpriteId::LOGO_05)) { SDL_Point sz = getSpriteSize(SpriteId::LOGO_05); drawSprite(SpriteId::LOGO_05, {(SCREEN_WIDTH-sz.x)/2,20,sz.x,sz.y}, LAYER_OVERLAY); }
+            int charW=CHARACTER_CARD_WIDTH,charH=CHARACTER_CARD_HEIGHT,gap=80,baseY=180,char1X=SCREEN_WIDTH/2-charW-gap/2,char2X=SCREEN_WIDTH/2+gap/2;
+            SDL_Rect r1={char1X,baseY,charW,charH},r2={char2X,baseY,charW,charH};
+            drawSprite(SpriteId::CHARACTER_01, r1, LAYER_OVERLAY);
+            drawSprite(SpriteId::CHARACTER_02, r2, LAYER_OVERLAY);
+            flushSprites(gRenderer);
+            SDL_SetRenderDrawColor(gRenderer,255,0,0,255);
+            if(gSelectedCharacter==0) SDL_RenderDrawRect(gRenderer,&r1); else SDL_RenderDrawRect(gRenderer,&r2);
+            countDrawCalls();
+            renderText("Select Your Character",SCREEN_WIDTH/2-120,baseY+charH+30,gFont,gHeaderColor,gRenderer);
+            renderText("Left/Right Arrows | Enter to Confirm | ESC to Cancel",SCREEN_WIDTH/2-250,baseY+charH+70,gFont,gTextColor,gRenderer);
+        } break;
+        default: break;
+    }
+    if (staticScreen) { countDrawCalls(endStaticScreen(gRenderer)); }
+    renderProfilerOverlay(gRenderer, gFont);
+}
@@ -6,8 +6,8 @@
 #include <SDL_mixer.h>
 #include <string>
 #include <vector>
-#include <random>
-#include "types.h" // For GameState, Barrier, Coin
+#include "types.h" // For GameState
+#include "world.h" // For World
 
 // Window Title (Actual definition in main.cpp)
 extern const char* const WINDOW_TITLE;
@@ -23,23 +23,10 @@ extern SDL_Color gAboutTextColor;
 extern SDL_Color gButtonHoverColor;
 extern SDL_Color gHeaderColor;
 
-// Textures
-extern SDL_Texture* gLogoTexture;
-extern SDL_Texture* gLogoTexture2;
-extern SDL_Texture* gLogoTexture3;
-extern SDL_Texture* gLogoTexture4;
-extern SDL_Texture* gLogoTexture5;
-extern SDL_Texture* gCharacter01Texture;
-extern SDL_Texture* gCharacter02Texture;
-extern SDL_Texture* gPlayerMaleTexture;
-extern SDL_Texture* gPlayerFemaleTexture;
-extern SDL_Texture* gCoinTexture;
-extern std::vector<SDL_Texture*> gMenuBgFrames;
+// Textures (logos, characters, menu frames, barriers and coins are atlas sprites, see sprites.h)
 extern std::vector<SDL_Texture*> gIntroSlides;
 extern SDL_Texture* gSkipButtonTexture;
-extern SDL_Texture* gGameBgFarTexture;
 extern SDL_Texture* gGameBgNearTexture;
-extern SDL_Texture* gBarrierTextures[3]; // Declaration for array of textures
 extern SDL_Texture* gLoseScreenTexture;
 extern SDL_Texture* gWinScreenTexture;
 
@@ -59,37 +46,25 @@ extern float gMenuAnimTimer;
 // Intro State
 extern int gCurrentIntroSlide;
 extern unsigned int gIntroSlideStartTime;
-extern int gIntroAudioChannel;
 
-// Gameplay Variables
-extern float gPlayerY;
-extern float gPlayerX;
-extern bool gMoveUp;
-extern bool gMoveDown;
-extern bool gMoveLeft;
-extern bool gMoveRight;
-extern float gGameTimer;
-extern float gWinDelayTimer;
-extern float gBackgroundX;
-
-// Barriers & Coins
-extern std::vector<Barrier> gBarriers;
-extern float gBarrierSpawnTimer;
-extern std::vector<Coin> gCoins;
-extern float gCoinSpawnTimer;
-extern int gCoinCounter;
-
-// Random Number Generation
-extern std::mt19937 gRandomGenerator;
+// Gameplay (see world.h; owned by the simulation thread while one runs)
+extern World gWorld;
+extern int gSimTickRate;
+extern bool gThreadedSimulation; // --serial-sim turns it off
+extern int gMaxBarriers;            // MAX_BARRIERS unless stress mode raises it
+extern int gMaxCoins;
+extern float gBarrierSpawnInterval;
+extern float gCoinSpawnInterval;
+extern bool gStressMode;
+extern Track gTrack;                // Segment templates streamed by every run; empty: generated
 
 // Game State
 extern GameState gCurrentState;
 
 // Sounds & Music
 extern Mix_Music* gMenuMusic;
-extern std::vector<Mix_Chunk*> gIntroAudio;
-extern Mix_Chunk* gLoseSound;
-extern Mix_Chunk* gWinSound;
+extern Mix_Music* gLoseSound; // Long sounds are streamed, see audio.h
+extern Mix_Music* gWinSound;
 
 
 #endif // GLOBALS_H
\ No newline at end of file
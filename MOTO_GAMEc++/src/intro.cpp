@@ -0,0 +1,79 @@
+#include <SDL.h>
+#include <SDL_mixer.h>
+#include <iostream>
+#include <string>
+
+#include "config.h"
+#include "globals.h"
+#include "assets.h"
+#include "audio.h"
+#include "intro.h"
+
+// --- Slide Residency ---
+namespace {
+
+bool sRequested[INTRO_SLIDE_COUNT] = {};
+Mix_Music* sNarration = nullptr; // Streamed from disk, only the current slide's is open
+
+// Queues the slide image on the loader threads (no-op if already requested)
+void requestSlide(int index) {
+    if (index < 0 || index >= INTRO_SLIDE_COUNT || sRequested[index]) return;
+    sRequested[index] = true;
+    queueTextureLoad("../assets/images/Intro/intro_slide_0" + std::to_string(index + 1) + ".png", &gIntroSlides[index], AssetGroup::INTRO, false, nullptr, exactSize(SCREEN_WIDTH, SCREEN_HEIGHT));
+}
+
+// Only called once the slide is delivered (the loader writes straight into the globals).
+// gIntroSlides is empty when loadMedia() failed before sizing it.
+void releaseSlide(int index) {
+    if (index < 0 || index >= INTRO_SLIDE_COUNT) return;
+    sRequested[index] = false;
+    if (index >= (int)gIntroSlides.size()) return;
+    if (gIntroSlides[index]) SDL_DestroyTexture(gIntroSlides[index]);
+    gIntroSlides[index] = nullptr;
+}
+
+} // namespace
+
+// --- Intro Flow ---
+void beginIntro(SDL_Renderer* renderer) {
+    gCurrentIntroSlide = 0;
+    requestSlide(0);
+    waitForAssetGroup(AssetGroup::INTRO, renderer);
+    requestSlide(1); // Decodes while slide 0 plays
+    playCurrentIntroAudio();
+}
+
+bool advanceIntroSlide(SDL_Renderer* renderer) {
+    closeStream(sNarration);
+    releaseSlide(gCurrentIntroSlide);
+    gCurrentIntroSlide++;
+    if (gCurrentIntroSlide >= INTRO_SLIDE_COUNT) {
+        endIntro(renderer);
+        return false;
+    }
+    requestSlide(gCurrentIntroSlide); // Normally already in flight
+    waitForAssetGroup(AssetGroup::INTRO, renderer); // Only stalls if the prefetch hasn't finished
+    requestSlide(gCurrentIntroSlide + 1);
+    playCurrentIntroAudio();
+    return true;
+}
+
+void endIntro(SDL_Renderer* renderer) {
+    closeStream(sNarration);
+    waitForAssetGroup(AssetGroup::INTRO, renderer); // A prefetch may still be decoding
+    for (int i = 0; i < INTRO_SLIDE_COUNT; ++i) releaseSlide(i);
+}
+
+bool isIntroNarrationFinished() {
+    return sNarration != nullptr && !isStreamPlaying(sNarration);
+}
+
+// Utility Function: Play Intro Audio
+void playCurrentIntroAudio() {
+    closeStream(sNarration);
+    if (gCurrentIntroSlide < INTRO_SLIDE_COUNT) {
+        sNarration = openStream("../assets/audio/intro_slide_0" + std::to_string(gCurrentIntroSlide + 1));
+        if (sNarration && !playStream(sNarration, 0)) { std::cerr << "WARNING: Failed to play intro audio " << gCurrentIntroSlide + 1 << "!" << std::endl; closeStream(sNarration); }
+    }
+    gIntroSlideStartTime = SDL_GetTicks();
+}
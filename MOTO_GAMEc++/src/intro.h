@@ -0,0 +1,18 @@
+#ifndef INTRO_H
+#define INTRO_H
+
+#include <SDL.h>
+
+// Streamed Intro
+// Slides are not part of the startup load. Slide N is decoded on demand, slide N+1
+// is prefetched on the loader threads while N plays, and each slide's texture is
+// freed as soon as the intro moves past it, so at most two slides are resident.
+// Narration is streamed from disk (see audio.h) and closed with its slide.
+
+void beginIntro(SDL_Renderer* renderer);         // Loads slide 0 (blocking) and starts narration
+bool advanceIntroSlide(SDL_Renderer* renderer);  // false once the last slide is done
+void endIntro(SDL_Renderer* renderer);           // Drains in-flight prefetches and frees every slide
+void playCurrentIntroAudio();
+bool isIntroNarrationFinished(); // The current slide's narration played to the end
+
+#endif // INTRO_H
@@ -0,0 +1,175 @@
+#include <SDL.h>
+#include <algorithm>
+#include <cstdio>
+#include <iostream>
+#include <string>
+
+#include "config.h"
+#include "latency.h"
+
+// --- Pending Inputs and Histograms ---
+namespace {
+
+struct PendingInput {
+    Uint64 stamp;
+    GameState state; // State the input arrived in
+    Uint64 frame;    // Presents so far when it arrived
+    bool visible;    // A frame being built reflects it
+    bool routed;     // Forwarded to the simulation thread: shown by the snapshot that applied it
+};
+
+// FIFO in stamp order; visible inputs leave at the next finishLatencyFrame() wherever they sit
+PendingInput sPending[LATENCY_MAX_PENDING];
+int sPendingHead = 0;
+int sPendingCount = 0;
+int sDropped = 0;      // Overflowed before any frame showed them
+Uint64 sLastStamp = 0;
+Uint64 sPresents = 0;
+bool sLateLatch = false;
+
+const int STATE_COUNT = (int)GameState::EXIT + 1;
+
+struct LatencyHistogram {
+    int buckets[LATENCY_HISTOGRAM_MS + 1]; // 1 ms each; the last one collects everything longer
+    int samples;
+    double sumMs;
+    double maxMs;
+    Uint64 frameSum;
+};
+LatencyHistogram sHistograms[STATE_COUNT];
+
+bool isTrackedInput(const SDL_Event& e) {
+    if (e.type == SDL_KEYDOWN) return e.key.repeat == 0;
+    return e.type == SDL_KEYUP || e.type == SDL_MOUSEBUTTONDOWN;
+}
+
+const char* stateName(GameState state) {
+    switch (state) {
+        case GameState::LOADING: return "LOADING";
+        case GameState::MENU: return "MENU";
+        case GameState::INTRO: return "INTRO";
+        case GameState::ABOUT: return "ABOUT";
+        case GameState::CHARACTER_SELECT: return "CHARACTER_SELECT";
+        case GameState::PLAYING: return "PLAYING";
+        case GameState::WIN_DELAY: return "WIN_DELAY";
+        case GameState::LOSE: return "LOSE";
+        case GameState::WIN: return "WIN";
+        default: return "EXIT";
+    }
+}
+
+void recordLatency(const PendingInput& input, Uint64 presentedAt) {
+    LatencyHistogram& h = sHistograms[(int)input.state];
+    double ms = presentedAt > input.stamp ? (double)(presentedAt - input.stamp) * 1000.0 / SDL_GetPerformanceFrequency() : 0.0;
+    h.buckets[std::min((int)ms, LATENCY_HISTOGRAM_MS)]++;
+    h.samples++;
+    h.sumMs += ms;
+    h.maxMs = std::max(h.maxMs, ms);
+    h.frameSum += sPresents - input.frame;
+}
+
+// Upper edge of the bucket holding the given fraction of samples
+int percentileMs(const LatencyHistogram& h, double fraction) {
+    int target = std::max(1, (int)(h.samples * fraction + 0.5));
+    int seen = 0;
+    for (int i = 0; i <= LATENCY_HISTOGRAM_MS; ++i) {
+        seen += h.buckets[i];
+        if (seen >= target) return i + 1;
+    }
+    return LATENCY_HISTOGRAM_MS + 1;
+}
+
+} // namespace
+
+// --- Public Interface ---
+Uint64 stampInputEvent(const SDL_Event& e, GameState state) {
+    if (!isTrackedInput(e)) return 0;
+    // The event sat in SDL's queue since e.common.timestamp (ms since SDL_Init)
+    Uint64 now = SDL_GetPerformanceCounter();
+    Uint32 ageMs = SDL_GetTicks() - e.common.timestamp;
+    Uint64 age = (Uint64)ageMs * SDL_GetPerformanceFrequency() / 1000;
+    Uint64 stamp = std::max(age < now ? now - age : 1, sLastStamp + 1); // Unique and increasing
+    sLastStamp = stamp;
+
+    if (sPendingCount == LATENCY_MAX_PENDING) { // Nothing presented in a long while: forget the oldest
+        sPendingHead = (sPendingHead + 1) % LATENCY_MAX_PENDING;
+        sPendingCount--;
+        sDropped++;
+    }
+    sPending[(sPendingHead + sPendingCount) % LATENCY_MAX_PENDING] = { stamp, state, sPresents, false, false };
+    sPendingCount++;
+    return stamp;
+}
+
+Uint64 getLatestInputStamp() { return sLastStamp; }
+
+void markInputsVisible(Uint64 upTo) {
+    for (int i = 0; i < sPendingCount; ++i) {
+        PendingInput& input = sPending[(sPendingHead + i) % LATENCY_MAX_PENDING];
+        if (input.stamp > upTo) break;
+        input.visible = true;
+    }
+}
+
+void markInputRouted(Uint64 stamp) {
+    for (int i = sPendingCount - 1; i >= 0; --i) {
+        PendingInput& input = sPending[(sPendingHead + i) % LATENCY_MAX_PENDING];
+        if (input.stamp == stamp) { input.routed = true; return; }
+        if (input.stamp < stamp) return;
+    }
+}
+
+void markUnroutedInputsVisible() {
+    for (int i = 0; i < sPendingCount; ++i) {
+        PendingInput& input = sPending[(sPendingHead + i) % LATENCY_MAX_PENDING];
+        if (!input.routed) input.visible = true;
+    }
+}
+
+void finishLatencyFrame(bool presented) {
+    Uint64 now = SDL_GetPerformanceCounter();
+    if (presented) sPresents++;
+    // Routed inputs can still wait for a snapshot while newer ones are done: compact in order
+    int kept = 0;
+    for (int i = 0; i < sPendingCount; ++i) {
+        const PendingInput& input = sPending[(sPendingHead + i) % LATENCY_MAX_PENDING];
+        if (input.visible) {
+            if (presented) recordLatency(input, now); // Skipped frame: the input changed nothing on screen
+            continue;
+        }
+        sPending[(sPendingHead + kept) % LATENCY_MAX_PENDING] = input;
+        kept++;
+    }
+    sPendingCount = kept;
+}
+
+void setLateLatch(bool enabled) { sLateLatch = enabled; }
+bool isLateLatchEnabled() { return sLateLatch; }
+
+void reportInputLatency() {
+    const int bands[] = { 8, 16, 24, 33, 50, 67, 100 };
+    bool any = false;
+    for (int s = 0; s < STATE_COUNT; ++s) {
+        const LatencyHistogram& h = sHistograms[s];
+        if (h.samples == 0) continue;
+        if (!any) std::cout << "Input latency (input queued -> present returned), late latch " << (sLateLatch ? "on" : "off") << ":" << std::endl;
+        any = true;
+        char line[192];
+        std::snprintf(line, sizeof(line), "  %-16s %5d inputs, mean %.1f ms, p50 %d ms, p95 %d ms, p99 %d ms, max %.1f ms, %.2f frames",
+            stateName((GameState)s), h.samples, h.sumMs / h.samples, percentileMs(h, 0.50), percentileMs(h, 0.95), percentileMs(h, 0.99),
+            h.maxMs, (double)h.frameSum / h.samples);
+        std::cout << line << std::endl;
+
+        // Coarse distribution: share of inputs under each band
+        std::string distribution = "   ";
+        int seen = 0, bucket = 0;
+        for (int band : bands) {
+            for (; bucket < std::min(band, LATENCY_HISTOGRAM_MS); ++bucket) seen += h.buckets[bucket];
+            std::snprintf(line, sizeof(line), " <%d ms %.0f%%", band, 100.0 * seen / h.samples);
+            distribution += line;
+        }
+        std::snprintf(line, sizeof(line), " | longer %.0f%%", 100.0 * (h.samples - seen) / h.samples);
+        std::cout << distribution << line << std::endl;
+    }
+    if (sDropped > 0) std::cout << "  " << sDropped << " input(s) dropped before any frame showed them." << std::endl;
+}
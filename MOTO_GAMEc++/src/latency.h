@@ -0,0 +1,40 @@
+#ifndef LATENCY_H
+#define LATENCY_H
+
+#include <SDL.h>
+#include "types.h"
+
+// Input-to-Photon Latency
+// Every key press/release and mouse click gets a stamp: the time SDL queued it
+// (event timestamp, refined to the performance counter), tagged with the state it
+// arrived in. Stamps are unique and increasing, so "every input up to stamp S" is
+// one comparison. The stamp travels with the input. On the main thread an input
+// is visible once a frame reflects it: at once for menu-style states, and after
+// the next tick for a session simulated on this thread. On the simulation thread
+// it goes through the input queue into the tick that applies it, and into the
+// snapshot that tick publishes (SimSnapshot::inputStamp). Inputs the main thread
+// handles itself while the simulation thread runs (clicks, menu keys, the ENTER
+// that started the run) are visible at once. When SDL_RenderPresent()
+// returns for a frame that showed it, the input's latency is recorded in a
+// per-state histogram. Under vsync that is when the flip is queued; scanout
+// follows within one refresh, which no API here can observe.
+//
+// Late latch (--late-latch): input is polled a second time right before
+// rendering, and in PLAYING the player sprite is interpolated with the motion the
+// currently held keys imply in place of the motion the last tick simulated. It
+// stays at the same point in time as the interpolated barriers and coins. The
+// simulation itself (and so replays) is unchanged; only what the frame shows gets
+// closer to the keys.
+
+Uint64 stampInputEvent(const SDL_Event& e, GameState state); // Before handleEvent(); 0: not an input we track
+Uint64 getLatestInputStamp();        // Stamp of the newest tracked input
+void markInputsVisible(Uint64 upTo); // The frame being built reflects every input with stamp <= upTo
+void markInputRouted(Uint64 stamp);  // Sent to the simulation thread: waits for a snapshot with it
+void markUnroutedInputsVisible();    // Simulation thread running: everything the main thread handled
+void finishLatencyFrame(bool presented); // After SDL_RenderPresent (true) or a skipped frame (false)
+
+void setLateLatch(bool enabled);
+bool isLateLatchEnabled();
+void reportInputLatency();
+
+#endif // LATENCY_H
@@ -0,0 +1,173 @@
+#include <SDL.h>
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "config.h"
+#include "pacer.h"
+
+// --- Pacer State ---
+namespace {
+
+double sTicksPerMs = 1.0;
+int sTargetFps = 0;
+int sRefreshRate = 60;
+bool sRendererVsync = false;
+
+bool sProbing = false;
+bool sVsyncBlocking = false;
+std::vector<double> sProbePresentMs;
+std::vector<double> sProbeIntervalMs;
+
+Uint64 sLastFrameEnd = 0;
+Uint64 sDeadline = 0;   // 0: resync on the next frame
+double sSleepMarginMs = PACER_INITIAL_SPIN_MARGIN_MS;
+
+// Accumulators since the last reset
+int sFrames = 0;
+double sIntervalSum = 0.0, sIntervalSqSum = 0.0, sMaxErrorMs = 0.0;
+double sSleepMs = 0.0, sSpinMs = 0.0;
+
+double ticksToMs(Uint64 ticks) { return (double)ticks / sTicksPerMs; }
+
+double median(std::vector<double> values) {
+    if (values.empty()) return 0.0;
+    std::nth_element(values.begin(), values.begin() + values.size() / 2, values.end());
+    return values[values.size() / 2];
+}
+
+bool isPacing() {
+    if (sTargetFps <= 0 || sProbing) return false;
+    return !sVsyncBlocking || sTargetFps < sRefreshRate - 1; // Below refresh vsync alone is too fast
+}
+
+// A blocking present shows up as frames locked near the refresh period with most of
+// that time spent inside SDL_RenderPresent
+void finishProbe() {
+    double refreshMs = 1000.0 / sRefreshRate;
+    double presentMs = median(sProbePresentMs), intervalMs = median(sProbeIntervalMs);
+    sVsyncBlocking = intervalMs >= refreshMs * 0.75 && presentMs >= refreshMs * 0.25;
+    sProbing = false;
+    sProbePresentMs.clear();
+    sProbeIntervalMs.clear();
+    std::cout << " -> Frame pacer: vsync " << (sVsyncBlocking ? "blocks" : "does not block") << " (median present " << presentMs << " ms, frame " << intervalMs
+              << " ms, display " << sRefreshRate << " Hz); " << (isPacing() ? "pacing to " + std::to_string(sTargetFps) + " fps." : "not pacing.") << std::endl;
+}
+
+// Hybrid wait: coarse SDL_Delay while the deadline is comfortably away, then spin
+void waitUntil(Uint64 deadline) {
+    Uint64 now = SDL_GetPerformanceCounter();
+    if (now >= deadline) return;
+    double remainingMs = ticksToMs(deadline - now);
+    if (remainingMs > sSleepMarginMs) {
+        Uint32 requestMs = (Uint32)(remainingMs - sSleepMarginMs);
+        if (requestMs > 0) {
+            Uint64 sleepStart = now;
+            SDL_Delay(requestMs);
+            now = SDL_GetPerformanceCounter();
+            double sleptMs = ticksToMs(now - sleepStart);
+            sSleepMs += sleptMs;
+            // Track the scheduler's overshoot so the spin window covers it, with a little headroom
+            double overshootMs = std::max(0.0, sleptMs - requestMs);
+            sSleepMarginMs = std::clamp(sSleepMarginMs * 0.9 + (overshootMs + 0.25) * 0.1, PACER_MIN_SPIN_MARGIN_MS, PACER_MAX_SPIN_MARGIN_MS);
+        }
+    }
+    Uint64 spinStart = now;
+    while (now < deadline) now = SDL_GetPerformanceCounter();
+    sSpinMs += ticksToMs(now - spinStart);
+}
+
+} // namespace
+
+// --- Public Interface ---
+void initFramePacer(SDL_Window* window, SDL_Renderer* renderer, int targetFps) {
+    sTicksPerMs = (double)SDL_GetPerformanceFrequency() / 1000.0;
+    SDL_RendererInfo info;
+    sRendererVsync = renderer && SDL_GetRendererInfo(renderer, &info) == 0 && (info.flags & SDL_RENDERER_PRESENTVSYNC);
+    SDL_DisplayMode mode;
+    int display = window ? SDL_GetWindowDisplayIndex(window) : -1;
+    sRefreshRate = (display >= 0 && SDL_GetCurrentDisplayMode(display, &mode) == 0 && mode.refresh_rate > 0) ? mode.refresh_rate : 60;
+    sTargetFps = std::max(0, targetFps);
+    sVsyncBlocking = false;
+    sProbing = sRendererVsync; // Without the flag there is nothing to probe
+    sProbePresentMs.clear();
+    sProbeIntervalMs.clear();
+    sLastFrameEnd = 0;
+    sDeadline = 0;
+    resetFramePacerStats();
+    if (!sProbing) std::cout << " -> Frame pacer: renderer has no vsync, pacing to " << sTargetFps << " fps (0 = uncapped)." << std::endl;
+}
+
+void setFramePacerTarget(int targetFps) {
+    sTargetFps = std::max(0, targetFps);
+    sDeadline = 0;
+    resetFramePacerStats();
+}
+
+int getFramePacerTarget() { return sTargetFps; }
+
+void resyncFramePacer() {
+    sLastFrameEnd = 0;
+    sDeadline = 0;
+}
+
+void paceFrame(Uint64 presentTicks) {
+    Uint64 now = SDL_GetPerformanceCounter();
+    if (sProbing && sLastFrameEnd != 0) {
+        sProbePresentMs.push_back(ticksToMs(presentTicks));
+        sProbeIntervalMs.push_back(ticksToMs(now - sLastFrameEnd));
+        if ((int)sProbeIntervalMs.size() >= PACER_PROBE_FRAMES) finishProbe();
+    }
+
+    if (isPacing()) {
+        Uint64 period = (Uint64)(sTicksPerMs * 1000.0 / sTargetFps);
+        if (sDeadline == 0 || now > sDeadline + period) sDeadline = now; // More than a frame behind: resync instead of bursting
+        else waitUntil(sDeadline);
+        sDeadline += period;
+        now = SDL_GetPerformanceCounter();
+    }
+
+    if (sLastFrameEnd != 0) {
+        double intervalMs = ticksToMs(now - sLastFrameEnd);
+        sFrames++;
+        sIntervalSum += intervalMs;
+        sIntervalSqSum += intervalMs * intervalMs;
+        double targetMs = sTargetFps > 0 ? 1000.0 / sTargetFps : intervalMs;
+        sMaxErrorMs = std::max(sMaxErrorMs, std::fabs(intervalMs - targetMs));
+    }
+    sLastFrameEnd = now;
+}
+
+FramePacerStats getFramePacerStats() {
+    FramePacerStats stats = {};
+    stats.probing = sProbing;
+    stats.vsyncBlocking = sVsyncBlocking;
+    stats.pacing = isPacing();
+    stats.targetFps = sTargetFps;
+    stats.refreshRate = sRefreshRate;
+    stats.frames = sFrames;
+    stats.sleepMarginMs = sSleepMarginMs;
+    if (sFrames > 0) {
+        stats.meanFrameMs = sIntervalSum / sFrames;
+        stats.jitterMs = std::sqrt(std::max(0.0, sIntervalSqSum / sFrames - stats.meanFrameMs * stats.meanFrameMs));
+        stats.maxErrorMs = sMaxErrorMs;
+        stats.sleepMsPerFrame = sSleepMs / sFrames;
+        stats.spinMsPerFrame = sSpinMs / sFrames;
+    }
+    return stats;
+}
+
+void resetFramePacerStats() {
+    sFrames = 0;
+    sIntervalSum = sIntervalSqSum = sMaxErrorMs = 0.0;
+    sSleepMs = sSpinMs = 0.0;
+}
+
+void reportFramePacer() {
+    FramePacerStats s = getFramePacerStats();
+    std::cout << "Frame pacer: " << (s.pacing ? "pacing to " + std::to_string(s.targetFps) + " fps" : (s.vsyncBlocking ? "vsync" : "uncapped"))
+              << ", " << s.frames << " frames, mean " << s.meanFrameMs << " ms, jitter " << s.jitterMs << " ms, max error " << s.maxErrorMs
+              << " ms, sleep " << s.sleepMsPerFrame << " ms + spin " << s.spinMsPerFrame << " ms per frame (margin " << s.sleepMarginMs << " ms)." << std::endl;
+}
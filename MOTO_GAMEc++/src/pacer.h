@@ -0,0 +1,42 @@
+#ifndef PACER_H
+#define PACER_H
+
+#include <SDL.h>
+
+// Frame Pacer
+// The renderer asks for vsync, but software/headless renderers (and some drivers)
+// ignore it and SDL_RenderPresent returns immediately. The pacer watches the first
+// frames to see whether present actually blocks. If it does not, or if the target
+// rate is below the display refresh, it holds the target rate itself: sleep with
+// SDL_Delay until shortly before the deadline, then spin the remainder. The sleep
+// margin adapts to the measured SDL_Delay overshoot, trading a little CPU for
+// sub-millisecond deadlines. A target of 0 disables pacing (uncapped).
+
+void initFramePacer(SDL_Window* window, SDL_Renderer* renderer, int targetFps);
+void setFramePacerTarget(int targetFps);
+int getFramePacerTarget();
+
+// Call right after SDL_RenderPresent with how long the present took; waits for the
+// next frame deadline when the pacer is active.
+void paceFrame(Uint64 presentTicks);
+void resyncFramePacer(); // After the loop blocked on purpose (idle screens)
+
+struct FramePacerStats {
+    bool probing;        // Still deciding whether vsync blocks
+    bool vsyncBlocking;
+    bool pacing;         // The pacer is holding the target rate
+    int targetFps;
+    int refreshRate;
+    int frames;
+    double meanFrameMs;  // Present-to-present interval
+    double jitterMs;     // Standard deviation of the interval
+    double maxErrorMs;   // Worst |interval - target period|
+    double sleepMsPerFrame;
+    double spinMsPerFrame;
+    double sleepMarginMs; // Current adaptive spin window
+};
+FramePacerStats getFramePacerStats(); // Since the last reset
+void resetFramePacerStats();
+void reportFramePacer();
+
+#endif // PACER_H
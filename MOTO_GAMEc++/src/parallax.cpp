@@ -0,0 +1,196 @@
+#include <SDL.h>
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "config.h"
+#include "archive.h"
+#include "sprites.h"
+#include "profiler.h"
+#include "parallax.h"
+#include "resolution.h"
+
+// --- Layers and Groups ---
+namespace {
+
+struct ParallaxLayer {
+    std::string image;
+    float scroll;
+    bool repeat;
+    SDL_Rect rect;                  // x = 0; y, w, h from the file
+    SDL_Texture* texture = nullptr; // Filled by the asset loader
+};
+
+// Layers with the same scroll, repeat mode and width move as one strip
+struct ParallaxGroup {
+    float scroll;
+    bool repeat;
+    int width;
+    int top, height;                  // Union of the member layers' rows
+    std::vector<int> layers;          // Indices into sLayers, in draw order
+    SDL_Texture* composite = nullptr; // Render target; only for groups of two or more
+    bool compositeValid = false;
+};
+
+std::vector<ParallaxLayer> sLayers;
+std::vector<ParallaxGroup> sGroups;
+bool sTargetsSupported = false;
+bool sTargetsChecked = false;
+
+bool parseLayers(const std::string& text, const std::string& sourceName) {
+    std::istringstream in(text);
+    std::string line;
+    int lineNumber = 0;
+    bool ok = true;
+    while (std::getline(in, line)) {
+        lineNumber++;
+        line = line.substr(0, line.find('#'));
+        std::istringstream words(line);
+        std::string directive, mode;
+        if (!(words >> directive)) continue;
+        ParallaxLayer layer;
+        layer.rect = { 0, 0, SCREEN_WIDTH, SCREEN_HEIGHT };
+        if (directive != "layer" || !(words >> layer.image >> layer.scroll >> mode >> layer.rect.y) || (mode != "repeat" && mode != "once")) {
+            std::cerr << "ERROR: " << sourceName << ":" << lineNumber << ": expected: layer <image> <scroll> repeat|once <y> [<width> <height>]" << std::endl;
+            ok = false;
+            continue;
+        }
+        if (words >> layer.rect.w) words >> layer.rect.h;
+        layer.repeat = mode == "repeat";
+        if (layer.rect.w <= 0 || layer.rect.h <= 0) { std::cerr << "ERROR: " << sourceName << ":" << lineNumber << ": layer size must be positive" << std::endl; ok = false; continue; }
+        sLayers.push_back(layer);
+    }
+    return ok && !sLayers.empty();
+}
+
+// Consecutive layers only: merging across a layer with another speed would change the draw order
+void buildGroups() {
+    sGroups.clear();
+    for (int i = 0; i < (int)sLayers.size(); ++i) {
+        const ParallaxLayer& layer = sLayers[i];
+        if (!sGroups.empty()) {
+            ParallaxGroup& last = sGroups.back();
+            if (last.scroll == layer.scroll && last.repeat == layer.repeat && last.width == layer.rect.w) {
+                int bottom = std::max(last.top + last.height, layer.rect.y + layer.rect.h);
+                last.top = std::min(last.top, layer.rect.y);
+                last.height = bottom - last.top;
+                last.layers.push_back(i);
+                continue;
+            }
+        }
+        ParallaxGroup group;
+        group.scroll = layer.scroll;
+        group.repeat = layer.repeat;
+        group.width = layer.rect.w;
+        group.top = layer.rect.y;
+        group.height = layer.rect.h;
+        group.layers.push_back(i);
+        sGroups.push_back(group);
+    }
+}
+
+bool compositeGroup(SDL_Renderer* renderer, ParallaxGroup& group) {
+    for (int index : group.layers) {
+        if (!sLayers[index].texture) return false; // Still loading: draw the layers one by one meanwhile
+    }
+    if (!group.composite) {
+        group.composite = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_TARGET, group.width, group.height);
+        if (!group.composite) { std::cerr << "WARNING: Unable to create parallax layer cache! SDL Error: " << SDL_GetError() << std::endl; return false; }
+        // Layers blended onto the cleared target leave premultiplied colour; BLEND would apply alpha twice
+        const SDL_BlendMode premultiplied = SDL_ComposeCustomBlendMode(SDL_BLENDFACTOR_ONE, SDL_BLENDFACTOR_ONE_MINUS_SRC_ALPHA, SDL_BLENDOPERATION_ADD,
+                                                                       SDL_BLENDFACTOR_ONE, SDL_BLENDFACTOR_ONE_MINUS_SRC_ALPHA, SDL_BLENDOPERATION_ADD);
+        if (SDL_SetTextureBlendMode(group.composite, premultiplied) != 0) {
+            std::cerr << "WARNING: Renderer has no premultiplied blending, drawing parallax layers one by one. SDL Error: " << SDL_GetError() << std::endl;
+            SDL_DestroyTexture(group.composite);
+            group.composite = nullptr;
+            sTargetsSupported = false;
+            return false;
+        }
+    }
+    SDL_Texture* previousTarget = SDL_GetRenderTarget(renderer);
+    if (SDL_SetRenderTarget(renderer, group.composite) != 0) { std::cerr << "WARNING: Unable to composite parallax layers! SDL Error: " << SDL_GetError() << std::endl; return false; }
+    Uint8 r, g, b, a; SDL_GetRenderDrawColor(renderer, &r, &g, &b, &a);
+    SDL_SetRenderDrawColor(renderer, 0, 0, 0, 0);
+    SDL_RenderClear(renderer);
+    SDL_SetRenderDrawColor(renderer, r, g, b, a);
+    for (int index : group.layers) {
+        const ParallaxLayer& layer = sLayers[index];
+        SDL_Rect dst = { 0, layer.rect.y - group.top, layer.rect.w, layer.rect.h };
+        SDL_RenderCopy(renderer, layer.texture, nullptr, &dst);
+    }
+    restoreRenderTarget(renderer, previousTarget);
+    countDrawCalls((int)group.layers.size());
+    group.compositeValid = true;
+    return true;
+}
+
+void drawStrip(SDL_Texture* texture, const ParallaxGroup& group, int y, int height, float scrollDistance) {
+    float offset = scrollDistance * group.scroll;
+    if (!group.repeat) {
+        int x = (int)std::floor(-offset);
+        if (x < SCREEN_WIDTH && x + group.width > 0) drawTextureBatched(texture, { x, y, group.width, height }, LAYER_BACKGROUND);
+        return;
+    }
+    int x = -(int)std::floor(std::fmod(offset, (float)group.width));
+    if (x > 0) x -= group.width; // Negative scroll (scrolling the other way)
+    for (; x < SCREEN_WIDTH; x += group.width) drawTextureBatched(texture, { x, y, group.width, height }, LAYER_BACKGROUND);
+}
+
+} // namespace
+
+// --- Public Interface ---
+bool loadParallaxLayers(const std::string& path, AssetGroup group) {
+    closeParallax();
+    std::string text;
+    bool loaded = readAssetText(path, text) && parseLayers(text, path);
+    if (!loaded) {
+        std::cerr << "WARNING: Parallax layers '" << path << "' not loaded, using the default background." << std::endl;
+        sLayers.clear();
+        ParallaxLayer far;
+        far.image = "../assets/images/background_far.png";
+        far.scroll = BACKGROUND_SCROLL_FACTOR;
+        far.repeat = true;
+        far.rect = { 0, -80, SCREEN_WIDTH, SCREEN_HEIGHT };
+        sLayers.push_back(far);
+    }
+    buildGroups();
+    // sLayers is complete, so the texture pointers handed to the loader stay put
+    for (ParallaxLayer& layer : sLayers) queueTextureLoad(layer.image, &layer.texture, group, true, nullptr, exactSize(layer.rect.w, layer.rect.h));
+    return loaded;
+}
+
+void renderParallax(SDL_Renderer* renderer, float scrollDistance) {
+    if (!sTargetsChecked) { sTargetsSupported = SDL_RenderTargetSupported(renderer) == SDL_TRUE; sTargetsChecked = true; }
+    for (ParallaxGroup& group : sGroups) {
+        if (group.layers.size() > 1 && sTargetsSupported && (group.compositeValid || compositeGroup(renderer, group))) {
+            drawStrip(group.composite, group, group.top, group.height, scrollDistance);
+            flushSprites(renderer);
+            continue;
+        }
+        for (int index : group.layers) { // Single layer, or no render targets
+            const ParallaxLayer& layer = sLayers[index];
+            if (!layer.texture) continue;
+            drawStrip(layer.texture, group, layer.rect.y, layer.rect.h, scrollDistance);
+            flushSprites(renderer); // The batch sorts by texture within a layer; keep the file order
+        }
+    }
+}
+
+void invalidateParallaxCache() {
+    for (ParallaxGroup& group : sGroups) group.compositeValid = false;
+}
+
+void closeParallax() {
+    for (ParallaxGroup& group : sGroups) {
+        if (group.composite) SDL_DestroyTexture(group.composite);
+    }
+    sGroups.clear();
+    for (ParallaxLayer& layer : sLayers) {
+        if (layer.texture) SDL_DestroyTexture(layer.texture);
+    }
+    sLayers.clear();
+    sTargetsChecked = false;
+}
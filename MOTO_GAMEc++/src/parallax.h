@@ -0,0 +1,26 @@
+#ifndef PARALLAX_H
+#define PARALLAX_H
+
+#include <SDL.h>
+#include <string>
+#include "assets.h"
+
+// Parallax Background
+// Any number of background layers, defined in a text file, one per line ('#' comments):
+//   layer <image> <scroll> repeat|once <y> [<width> <height>]
+// scroll is the layer's speed as a fraction of the road (0 = fixed, 1 = moves with the
+// barriers); width/height default to the screen size. Layers are drawn in file order.
+// Consecutive layers that share scroll, repeat mode and width are pre-composited into
+// one cached render target, so a frame costs about one draw per scroll speed rather
+// than one per layer. Caches are rebuilt after a render target reset.
+
+// Queues the layer images on the asset loader; without the file the classic far
+// background is used (returns false). Call once from loadMedia().
+bool loadParallaxLayers(const std::string& path, AssetGroup group);
+// Draws every layer for a scroll distance (pixels the road has moved). Goes through the
+// sprite batch at LAYER_BACKGROUND and flushes it once per cached group.
+void renderParallax(SDL_Renderer* renderer, float scrollDistance);
+void invalidateParallaxCache(); // Call on SDL_RENDER_TARGETS_RESET / SDL_RENDER_DEVICE_RESET
+void closeParallax();
+
+#endif // PARALLAX_H
@@ -0,0 +1,233 @@
+#include <SDL.h>
+#include <SDL_ttf.h>
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "profiler.h"
+#include "frame_arena.h"
+#include "sprites.h"
+#include "text.h"
+
+// --- Frame History ---
+namespace {
+
+const int PROFILER_HISTORY_FRAMES = 240;
+const int PROFILER_MAX_SCOPES = 128; // Per frame; later scopes are dropped
+const double TARGET_FRAME_MS = 1000.0 / 60.0;
+
+struct ScopeRecord {
+    const char* name;
+    Uint64 start; // Counter ticks since sEpoch
+    Uint64 duration;
+};
+
+struct FrameRecord {
+    Uint64 start;
+    Uint64 duration;
+    int drawCalls;
+    int scopeCount;
+    int droppedScopes;
+    ScopeRecord scopes[PROFILER_MAX_SCOPES];
+};
+
+std::vector<FrameRecord> sFrames(PROFILER_HISTORY_FRAMES); // Allocated once
+int sNewestFrame = -1;
+int sFrameCount = 0;
+bool sFrameOpen = false;
+bool sOverlayVisible = false;
+Uint64 sEpoch = 0; // Set on the first frame
+thread_local bool tFrameThread = false; // Scopes on other threads (simulation, loaders) are not recorded
+
+FrameRecord& currentFrame() { return sFrames[sNewestFrame]; }
+
+double ticksToMs(Uint64 ticks) { return (double)ticks * 1000.0 / (double)SDL_GetPerformanceFrequency(); }
+
+// Oldest to newest
+template <typename Fn>
+void forEachFrame(Fn fn) {
+    int first = (sNewestFrame - sFrameCount + 1 + PROFILER_HISTORY_FRAMES) % PROFILER_HISTORY_FRAMES;
+    for (int i = 0; i < sFrameCount; ++i) fn(sFrames[(first + i) % PROFILER_HISTORY_FRAMES]);
+}
+
+int completedFrames() { return sFrameOpen ? sFrameCount - 1 : sFrameCount; }
+
+double percentile(const FrameVector<double>& sorted, double p) {
+    if (sorted.empty()) return 0.0;
+    size_t index = (size_t)(p * (sorted.size() - 1) + 0.5);
+    return sorted[std::min(index, sorted.size() - 1)];
+}
+
+} // namespace
+
+// --- Scopes ---
+ProfileScope::ProfileScope(const char* name) : mName(name), mStart(SDL_GetPerformanceCounter()) {}
+
+ProfileScope::~ProfileScope() {
+    if (!tFrameThread || !sFrameOpen) return;
+    FrameRecord& frame = currentFrame();
+    if (frame.scopeCount >= PROFILER_MAX_SCOPES) { frame.droppedScopes++; return; }
+    frame.scopes[frame.scopeCount++] = { mName, mStart - sEpoch, SDL_GetPerformanceCounter() - mStart };
+}
+
+void beginProfilerFrame() {
+    if (sFrameOpen) endProfilerFrame();
+    if (sEpoch == 0) sEpoch = SDL_GetPerformanceCounter();
+    tFrameThread = true;
+    sNewestFrame = (sNewestFrame + 1) % PROFILER_HISTORY_FRAMES;
+    sFrameCount = std::min(sFrameCount + 1, PROFILER_HISTORY_FRAMES);
+    FrameRecord& frame = currentFrame();
+    frame.start = SDL_GetPerformanceCounter() - sEpoch;
+    frame.duration = 0;
+    frame.drawCalls = 0;
+    frame.scopeCount = 0;
+    frame.droppedScopes = 0;
+    sFrameOpen = true;
+}
+
+void endProfilerFrame() {
+    if (!sFrameOpen) return;
+    FrameRecord& frame = currentFrame();
+    frame.duration = SDL_GetPerformanceCounter() - sEpoch - frame.start;
+    sFrameOpen = false;
+}
+
+void countDrawCalls(int calls) {
+    if (sFrameOpen) currentFrame().drawCalls += calls;
+}
+
+int getLastFrameDrawCalls() {
+    if (completedFrames() <= 0) return 0;
+    int index = sFrameOpen ? (sNewestFrame - 1 + PROFILER_HISTORY_FRAMES) % PROFILER_HISTORY_FRAMES : sNewestFrame;
+    return sFrames[index].drawCalls;
+}
+
+// --- Statistics ---
+FrameTimeStats getFrameTimeStats() {
+    FrameTimeStats stats = {};
+    FrameVector<double> times; // Called every frame while the overlay is up
+    times.reserve(PROFILER_HISTORY_FRAMES);
+    double drawCalls = 0.0;
+    int remaining = completedFrames();
+    forEachFrame([&](const FrameRecord& frame) {
+        if (remaining-- <= 0) return; // Skip the open frame
+        times.push_back(ticksToMs(frame.duration));
+        drawCalls += frame.drawCalls;
+    });
+    if (times.empty()) return stats;
+
+    stats.frames = (int)times.size();
+    for (double t : times) stats.meanMs += t;
+    stats.meanMs /= times.size();
+    stats.drawCallsPerFrame = drawCalls / times.size();
+    std::sort(times.begin(), times.end());
+    stats.p50Ms = percentile(times, 0.50);
+    stats.p95Ms = percentile(times, 0.95);
+    stats.p99Ms = percentile(times, 0.99);
+    stats.maxMs = times.back();
+    return stats;
+}
+
+void resetProfiler() {
+    sNewestFrame = -1;
+    sFrameCount = 0;
+    sFrameOpen = false;
+}
+
+// --- Overlay ---
+void toggleProfilerOverlay() { sOverlayVisible = !sOverlayVisible; }
+bool isProfilerOverlayVisible() { return sOverlayVisible; }
+
+void renderProfilerOverlay(SDL_Renderer* renderer, TTF_Font* font) {
+    if (!sOverlayVisible || completedFrames() <= 0) return;
+    PROFILE_SCOPE("profiler overlay");
+
+    const int panelX = 10, panelY = 50, graphH = 100, barW = 2;
+    const int panelW = PROFILER_HISTORY_FRAMES * barW + 20;
+    const double msPerPixel = (2.0 * TARGET_FRAME_MS) / graphH; // Top of the graph is two frames at 60 Hz
+
+    // Per-scope averages over the history, in first-seen order
+    FrameVector<std::pair<const char*, double>> scopeTotals;
+    scopeTotals.reserve(PROFILER_MAX_SCOPES);
+    int remaining = completedFrames();
+    forEachFrame([&](const FrameRecord& frame) {
+        if (remaining-- <= 0) return;
+        for (int i = 0; i < frame.scopeCount; ++i) {
+            const char* name = frame.scopes[i].name;
+            auto it = std::find_if(scopeTotals.begin(), scopeTotals.end(), [name](const std::pair<const char*, double>& s) { return s.first == name || std::strcmp(s.first, name) == 0; });
+            if (it == scopeTotals.end()) { scopeTotals.push_back({ name, 0.0 }); it = scopeTotals.end() - 1; }
+            it->second += ticksToMs(frame.scopes[i].duration);
+        }
+    });
+
+    int lineH = font ? TTF_FontLineSkip(font) : 30;
+    int panelH = graphH + 20 + lineH * (2 + (int)scopeTotals.size());
+    drawRectBatched({ panelX, panelY, panelW, panelH }, { 0, 0, 0, 180 }, LAYER_OVERLAY);
+
+    // Frame-time graph, newest on the right; green under budget, yellow under 2x, red above
+    int graphBottom = panelY + 10 + graphH, x = panelX + 10;
+    remaining = completedFrames();
+    forEachFrame([&](const FrameRecord& frame) {
+        if (remaining-- <= 0) return;
+        double ms = ticksToMs(frame.duration);
+        int h = std::min(graphH, std::max(1, (int)(ms / msPerPixel)));
+        SDL_Color color = ms <= TARGET_FRAME_MS ? SDL_Color{ 80, 220, 80, 255 } : (ms <= 2.0 * TARGET_FRAME_MS ? SDL_Color{ 240, 200, 40, 255 } : SDL_Color{ 230, 60, 60, 255 });
+        drawRectBatched({ x, graphBottom - h, barW, h }, color, LAYER_OVERLAY);
+        x += barW;
+    });
+    int budgetY = graphBottom - (int)(TARGET_FRAME_MS / msPerPixel);
+    drawRectBatched({ panelX + 10, budgetY, PROFILER_HISTORY_FRAMES * barW, 1 }, { 255, 255, 255, 160 }, LAYER_OVERLAY);
+
+    SDL_BlendMode previousBlend;
+    SDL_GetRenderDrawBlendMode(renderer, &previousBlend);
+    SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND); // Untextured geometry uses the draw blend mode
+    flushSprites(renderer);
+    SDL_SetRenderDrawBlendMode(renderer, previousBlend);
+
+    if (!font) return;
+    FrameTimeStats stats = getFrameTimeStats();
+    SDL_Color white = { 255, 255, 255, 255 };
+    char line[128];
+    int textY = graphBottom + 10;
+    std::snprintf(line, sizeof(line), "frame ms  p50 %.2f  p95 %.2f  p99 %.2f  max %.2f", stats.p50Ms, stats.p95Ms, stats.p99Ms, stats.maxMs);
+    renderDynamicText(line, panelX + 10, textY, font, white, renderer); textY += lineH;
+    std::snprintf(line, sizeof(line), "draw calls/frame %.1f  (%d frames)", stats.drawCallsPerFrame, stats.frames);
+    renderDynamicText(line, panelX + 10, textY, font, white, renderer); textY += lineH;
+    for (const auto& scope : scopeTotals) {
+        std::snprintf(line, sizeof(line), "  %-16s %.3f ms", scope.first, scope.second / stats.frames);
+        renderDynamicText(line, panelX + 10, textY, font, white, renderer); textY += lineH;
+    }
+}
+
+// --- Trace Export ---
+bool writeProfilerTrace(const std::string& path) {
+    FILE* file = std::fopen(path.c_str(), "w");
+    if (!file) { std::cerr << "ERROR: Unable to write profiler trace " << path << "!" << std::endl; return false; }
+
+    double usPerTick = 1e6 / (double)SDL_GetPerformanceFrequency();
+    bool first = true;
+    auto writeEvent = [&](const char* name, Uint64 start, Uint64 duration, int drawCalls) {
+        std::fprintf(file, "%s\n{\"name\":\"%s\",\"ph\":\"X\",\"pid\":1,\"tid\":1,\"ts\":%.3f,\"dur\":%.3f", first ? "" : ",", name, start * usPerTick, duration * usPerTick);
+        if (drawCalls >= 0) std::fprintf(file, ",\"args\":{\"drawCalls\":%d}", drawCalls);
+        std::fputc('}', file);
+        first = false;
+    };
+
+    std::fprintf(file, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[");
+    int written = 0;
+    int remaining = completedFrames();
+    forEachFrame([&](const FrameRecord& frame) {
+        if (remaining-- <= 0) return;
+        writeEvent("frame", frame.start, frame.duration, frame.drawCalls);
+        for (int i = 0; i < frame.scopeCount; ++i) writeEvent(frame.scopes[i].name, frame.scopes[i].start, frame.scopes[i].duration, -1);
+        written++;
+    });
+    std::fprintf(file, "\n]}\n");
+    bool ok = std::fclose(file) == 0;
+    if (ok) std::cout << "Profiler trace written to " << path << " (" << written << " frames)." << std::endl;
+    return ok;
+}
@@ -0,0 +1,53 @@
+#ifndef PROFILER_H
+#define PROFILER_H
+
+#include <SDL.h>
+#include <SDL_ttf.h>
+#include <string>
+
+// Frame Profiler
+// PROFILE_SCOPE("name") times the enclosing block with SDL_GetPerformanceCounter
+// and records it into the current frame. The last PROFILER_HISTORY_FRAMES frames
+// are kept in a ring buffer with their draw-call counts. Names must be string
+// literals (only the pointer is stored); scopes only count on the thread that calls
+// beginProfilerFrame(). F3 toggles the overlay, F4 writes the
+// ring buffer as Chrome trace JSON (open in chrome://tracing or Perfetto).
+
+class ProfileScope {
+public:
+    explicit ProfileScope(const char* name);
+    ~ProfileScope();
+    ProfileScope(const ProfileScope&) = delete;
+    ProfileScope& operator=(const ProfileScope&) = delete;
+private:
+    const char* mName;
+    Uint64 mStart;
+};
+
+#define PROFILE_CONCAT_INNER(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_INNER(a, b)
+#define PROFILE_SCOPE(name) ProfileScope PROFILE_CONCAT(profileScope_, __LINE__)(name)
+
+void beginProfilerFrame(); // Closes the previous frame if it is still open
+void endProfilerFrame();
+void countDrawCalls(int calls = 1);
+int getLastFrameDrawCalls(); // Most recently completed frame
+
+struct FrameTimeStats {
+    int frames;
+    double meanMs;
+    double p50Ms;
+    double p95Ms;
+    double p99Ms;
+    double maxMs;
+    double drawCallsPerFrame;
+};
+FrameTimeStats getFrameTimeStats(); // Over the frames currently in the ring buffer
+void resetProfiler();               // Drops the history (e.g. between benchmark runs)
+
+void toggleProfilerOverlay();
+bool isProfilerOverlayVisible();
+void renderProfilerOverlay(SDL_Renderer* renderer, TTF_Font* font);
+bool writeProfilerTrace(const std::string& path);
+
+#endif // PROFILER_H
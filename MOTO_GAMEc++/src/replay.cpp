@@ -0,0 +1,276 @@
+#include <SDL.h>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "config.h"
+#include "globals.h"
+#include "replay.h"
+
+// --- Run Data ---
+namespace {
+
+const char REPLAY_MAGIC[8] = { 'M', 'O', 'T', 'O', 'R', 'E', 'P', '1' };
+const Uint32 REPLAY_VERSION = 4; // 2: track segment spawning, 3: swept collision, 4: collision masks
+
+struct RunData {
+    Uint32 seed = 0;
+    Uint32 tickRate = 0;
+    Uint8 character = 0;
+    Uint8 outcome = 0; // GameState the run ended in
+    Uint32 tickCount = 0;
+    Uint32 coins = 0;
+    Uint64 checksum = 0;
+    std::vector<Uint8> inputStream; // (varint tick delta, bits) pairs
+};
+
+// Walks an encoded input stream one tick at a time
+struct InputCursor {
+    const std::vector<Uint8>* stream = nullptr;
+    size_t pos = 0;
+    Uint32 nextChangeTick = 0;
+    bool hasNext = false;
+    Uint8 bits = 0;
+
+    void reset(const std::vector<Uint8>& s) { stream = &s; pos = 0; bits = 0; nextChangeTick = 0; readDelta(0); }
+
+    void readDelta(Uint32 fromTick) {
+        Uint32 delta = 0;
+        int shift = 0;
+        hasNext = false;
+        while (pos < stream->size()) {
+            Uint8 byte = (*stream)[pos++];
+            delta |= (Uint32)(byte & 0x7F) << shift;
+            shift += 7;
+            if (!(byte & 0x80)) { hasNext = pos < stream->size(); break; }
+        }
+        nextChangeTick = fromTick + delta;
+    }
+
+    Uint8 bitsForTick(Uint32 tick) {
+        while (hasNext && nextChangeTick == tick) {
+            bits = (*stream)[pos++];
+            readDelta(tick);
+        }
+        return bits;
+    }
+};
+
+std::random_device sSeedSource;
+
+bool sRunActive = false;
+Uint32 sRunTick = 0;
+RunData sCurrent;
+Uint32 sLastChangeTick = 0;
+Uint8 sLastBits = 0;
+
+std::string sRecordPath;
+bool sPlayback = false;
+RunData sReplay;
+InputCursor sReplayCursor;
+
+std::string sGhostPath;
+bool sGhostEnabled = false;
+bool sHasGhost = false;
+RunData sGhost;
+InputCursor sGhostCursor;
+Uint32 sGhostTick = 0;
+float sGhostX = 0.0f, sGhostY = 0.0f, sGhostPrevX = 0.0f, sGhostPrevY = 0.0f;
+
+void appendVarint(std::vector<Uint8>& out, Uint32 value) {
+    do {
+        Uint8 byte = value & 0x7F;
+        value >>= 7;
+        out.push_back(value ? (Uint8)(byte | 0x80) : byte);
+    } while (value);
+}
+
+// FNV-1a over everything the simulation produced
+Uint64 hashBytes(Uint64 hash, const void* data, size_t size) {
+    const Uint8* bytes = (const Uint8*)data;
+    for (size_t i = 0; i < size; ++i) { hash ^= bytes[i]; hash *= 1099511628211ULL; }
+    return hash;
+}
+
+Uint64 hashEntities(Uint64 hash, const EntityStore& store) {
+    hash = hashBytes(hash, &store.count, sizeof(store.count));
+    if (store.count == 0) return hash;
+    hash = hashBytes(hash, store.x.data(), store.count * sizeof(float));
+    hash = hashBytes(hash, store.y.data(), store.count * sizeof(float));
+    return hashBytes(hash, store.type.data(), store.count * sizeof(store.type[0]));
+}
+
+Uint64 simulationChecksum(const World& world) {
+    Uint64 hash = 14695981039346656037ULL;
+    hash = hashBytes(hash, &sRunTick, sizeof(sRunTick));
+    hash = hashBytes(hash, &world.playerX, sizeof(world.playerX));
+    hash = hashBytes(hash, &world.playerY, sizeof(world.playerY));
+    hash = hashBytes(hash, &world.gameTimer, sizeof(world.gameTimer));
+    hash = hashBytes(hash, &world.coinCounter, sizeof(world.coinCounter));
+    hash = hashEntities(hash, world.barriers);
+    return hashEntities(hash, world.coins);
+}
+
+template <typename T>
+bool writeField(FILE* file, const T& value) { return std::fwrite(&value, sizeof(T), 1, file) == 1; }
+
+template <typename T>
+bool readField(FILE* file, T& value) { return std::fread(&value, sizeof(T), 1, file) == 1; }
+
+bool saveRun(const std::string& path, const RunData& run) {
+    FILE* file = std::fopen(path.c_str(), "wb");
+    if (!file) { std::cerr << "WARNING: Unable to write replay " << path << "!" << std::endl; return false; }
+    Uint32 streamBytes = (Uint32)run.inputStream.size();
+    bool ok = std::fwrite(REPLAY_MAGIC, sizeof(REPLAY_MAGIC), 1, file) == 1
+        && writeField(file, REPLAY_VERSION) && writeField(file, run.seed) && writeField(file, run.tickRate)
+        && writeField(file, run.character) && writeField(file, run.outcome) && writeField(file, run.tickCount)
+        && writeField(file, run.coins) && writeField(file, run.checksum) && writeField(file, streamBytes)
+        && (streamBytes == 0 || std::fwrite(run.inputStream.data(), 1, streamBytes, file) == streamBytes);
+    ok = std::fclose(file) == 0 && ok;
+    if (!ok) std::cerr << "WARNING: Replay " << path << " could not be written completely!" << std::endl;
+    return ok;
+}
+
+bool readRun(const std::string& path, RunData& run) {
+    FILE* file = std::fopen(path.c_str(), "rb");
+    if (!file) return false;
+    char magic[sizeof(REPLAY_MAGIC)];
+    Uint32 version = 0, streamBytes = 0;
+    bool ok = std::fread(magic, sizeof(magic), 1, file) == 1 && std::memcmp(magic, REPLAY_MAGIC, sizeof(magic)) == 0
+        && readField(file, version) && version == REPLAY_VERSION
+        && readField(file, run.seed) && readField(file, run.tickRate) && readField(file, run.character)
+        && readField(file, run.outcome) && readField(file, run.tickCount) && readField(file, run.coins)
+        && readField(file, run.checksum) && readField(file, streamBytes);
+    if (ok) {
+        run.inputStream.resize(streamBytes);
+        ok = streamBytes == 0 || std::fread(run.inputStream.data(), 1, streamBytes, file) == streamBytes;
+    }
+    std::fclose(file);
+    if (!ok) std::cerr << "WARNING: Replay " << path << " is invalid or from another version!" << std::endl;
+    return ok;
+}
+
+// Abandoned runs never count; a win beats a loss, then coins, then survival time
+bool isBetterRun(const RunData& a, const RunData& b) {
+    if ((GameState)a.outcome == GameState::MENU) return false;
+    bool aWon = (GameState)a.outcome == GameState::WIN_DELAY, bWon = (GameState)b.outcome == GameState::WIN_DELAY;
+    if (aWon != bWon) return aWon;
+    if (aWon && a.coins != b.coins) return a.coins > b.coins;
+    return a.tickCount > b.tickCount;
+}
+
+} // namespace
+
+// --- Modes ---
+bool startRecording(const std::string& path) {
+    sRecordPath = path;
+    std::cout << " -> Recording runs to " << path << std::endl;
+    return true;
+}
+
+bool loadReplay(const std::string& path) {
+    if (!readRun(path, sReplay)) { std::cerr << "ERROR: Unable to load replay " << path << "!" << std::endl; return false; }
+    sPlayback = true;
+    gSimTickRate = (int)sReplay.tickRate; // Ticks must line up with the recording
+    gSelectedCharacter = sReplay.character; // Before resetGameState() picks the player's collision mask
+    std::cout << " -> Replaying " << path << " (seed " << sReplay.seed << ", " << sReplay.tickCount << " ticks at " << sReplay.tickRate << " Hz, "
+              << sReplay.inputStream.size() << " input bytes)" << std::endl;
+    return true;
+}
+
+bool enableGhost(const std::string& path) {
+    sGhostPath = path;
+    sGhostEnabled = true;
+    sHasGhost = readRun(path, sGhost);
+    if (sHasGhost && (int)sGhost.tickRate != gSimTickRate) {
+        std::cerr << "WARNING: Ghost " << path << " was recorded at " << sGhost.tickRate << " Hz, not " << gSimTickRate << " Hz; it will be replaced." << std::endl;
+        sHasGhost = false;
+    }
+    std::cout << " -> Ghost rider: " << (sHasGhost ? "racing " + path : "no best run yet, the first run becomes the ghost") << std::endl;
+    return true;
+}
+
+bool isReplayPlayback() { return sPlayback; }
+
+// --- Run Lifecycle ---
+void beginRun(World& world) {
+    std::vector<Uint8> stream = std::move(sCurrent.inputStream); // Keep the capacity: recording stays off the heap
+    stream.clear();
+    stream.reserve(REPLAY_STREAM_RESERVE_BYTES);
+    sCurrent = RunData();
+    sCurrent.inputStream = std::move(stream);
+    sCurrent.seed = sPlayback ? sReplay.seed : sSeedSource();
+    sCurrent.tickRate = (Uint32)gSimTickRate;
+    sCurrent.character = (Uint8)gSelectedCharacter;
+    seedWorld(world, sCurrent.seed);
+    sRunTick = 0;
+    sLastChangeTick = 0;
+    sLastBits = 0;
+    sRunActive = true;
+    if (sPlayback) sReplayCursor.reset(sReplay.inputStream);
+
+    if (sHasGhost) {
+        sGhostCursor.reset(sGhost.inputStream);
+        sGhostTick = 0;
+        sGhostX = sGhostPrevX = world.playerX;
+        sGhostY = sGhostPrevY = world.playerY;
+    }
+}
+
+Uint8 applyRunInput(Uint8 liveBits) {
+    if (!sRunActive) return liveBits;
+    Uint8 bits = sPlayback ? sReplayCursor.bitsForTick(sRunTick) : liveBits;
+    if (sRunTick == 0 || bits != sLastBits) {
+        appendVarint(sCurrent.inputStream, sRunTick - sLastChangeTick);
+        sCurrent.inputStream.push_back(bits);
+        sLastChangeTick = sRunTick;
+        sLastBits = bits;
+    }
+    sRunTick++;
+    return bits;
+}
+
+bool finishRun(GameState outcome, const World& world) {
+    if (!sRunActive) return false;
+    sRunActive = false;
+    sCurrent.outcome = (Uint8)outcome;
+    sCurrent.tickCount = sRunTick;
+    sCurrent.coins = (Uint32)world.coinCounter;
+    sCurrent.checksum = simulationChecksum(world);
+
+    if (!sRecordPath.empty() && saveRun(sRecordPath, sCurrent)) {
+        std::cout << "Run recorded to " << sRecordPath << " (" << sCurrent.tickCount << " ticks, " << sCurrent.inputStream.size() << " input bytes)." << std::endl;
+    }
+    if (sGhostEnabled && !sPlayback && (!sHasGhost || isBetterRun(sCurrent, sGhost))) {
+        if (saveRun(sGhostPath, sCurrent)) std::cout << "New best run saved as the ghost (" << sGhostPath << ")." << std::endl;
+        sGhost = sCurrent;
+        sHasGhost = (GameState)sGhost.outcome != GameState::MENU;
+    }
+    if (sPlayback) {
+        bool exact = sCurrent.tickCount == sReplay.tickCount && sCurrent.checksum == sReplay.checksum && sCurrent.outcome == sReplay.outcome;
+        if (exact) std::cout << "Replay verified: bit-exact (" << sCurrent.tickCount << " ticks)." << std::endl;
+        else std::cerr << "WARNING: Replay diverged! Ended after " << sCurrent.tickCount << " ticks (recorded " << sReplay.tickCount << "), checksum "
+                       << (sCurrent.checksum == sReplay.checksum ? "matches." : "differs.") << std::endl;
+        return true;
+    }
+    return false;
+}
+
+// --- Ghost ---
+void stepGhost(float deltaTime) {
+    if (!sHasGhost || sGhostTick >= sGhost.tickCount) return;
+    sGhostPrevX = sGhostX;
+    sGhostPrevY = sGhostY;
+    stepPlayer(sGhostX, sGhostY, sGhostCursor.bitsForTick(sGhostTick), deltaTime);
+    sGhostTick++;
+}
+
+GhostPose getGhostPose() {
+    GhostPose pose = {};
+    if (!sHasGhost || !sRunActive || sGhostTick >= sGhost.tickCount) return pose;
+    pose = { true, sGhostX, sGhostY, sGhostPrevX, sGhostPrevY, sGhost.character };
+    return pose;
+}
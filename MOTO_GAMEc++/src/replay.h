@@ -0,0 +1,40 @@
+#ifndef REPLAY_H
+#define REPLAY_H
+
+#include <SDL.h>
+#include <string>
+#include "types.h"
+#include "world.h" // RunInputBits
+
+// Deterministic Runs, Replays and Ghost
+// A run is one PLAYING session. Each run reseeds the World's RNG, and the
+// simulation only sees input through the per-tick move bits returned by
+// applyRunInput(), so seed + tick rate + input stream reproduce the run exactly
+// (same build: std:: distributions are implementation-defined across libraries).
+// The input stream is delta-encoded: an entry is written only when the bits
+// change, as (varint ticks since the previous entry, bits).
+//   --record <file>  saves every finished run (the latest overwrites)
+//   --replay <file>  plays a run back instead of live input, verifies the final
+//                    state checksum and exits; doubles as a perf workload
+//   --ghost [file]   draws the best run (default best_run.rep) next to the
+//                    player and saves any better run over it
+
+bool startRecording(const std::string& path);
+bool loadReplay(const std::string& path); // Also adopts the recorded tick rate and character
+bool enableGhost(const std::string& path); // A missing file is fine: the first run becomes the ghost
+bool isReplayPlayback();
+
+// Called from whichever thread runs the session (see sim_thread.h), never two at once
+void beginRun(World& world);                // From resetGameState(): seeds the RNG, starts recording/playback/ghost
+Uint8 applyRunInput(Uint8 liveBits);        // Once per PLAYING tick: the bits to simulate (playback ignores liveBits)
+bool finishRun(GameState outcome, const World& world); // LOSE, WIN_DELAY (won) or MENU (abandoned); true: playback done, quit
+
+struct GhostPose {
+    bool visible;
+    float x, y, prevX, prevY;
+    int character;
+};
+void stepGhost(float deltaTime);
+GhostPose getGhostPose();
+
+#endif // REPLAY_H
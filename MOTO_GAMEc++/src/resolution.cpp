@@ -0,0 +1,170 @@
+#include <SDL.h>
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <iostream>
+
+#include "config.h"
+#include "resolution.h"
+
+// --- Scene Target ---
+namespace {
+
+SDL_Texture* sScene = nullptr; // SCREEN_WIDTH x SCREEN_HEIGHT; the top-left w x h is in use
+bool sSceneActive = false;     // Between beginSceneFrame() and endSceneFrame()
+float sScale = 1.0f;
+int sSceneW = SCREEN_WIDTH;
+int sSceneH = SCREEN_HEIGHT;
+int sFinishedW = 0; // Size of the scene the last endSceneFrame() upscaled; 0 if none
+int sFinishedH = 0;
+
+// Controller
+bool sDynamic = false;
+double sBudgetMs = 0.0;
+double sSmoothedMs = 0.0;
+int sCooldown = 0;
+
+// Stats
+int sFrames = 0;
+int sChanges = 0;
+double sScaleSum = 0.0;
+float sLowestScale = 1.0f;
+
+void applyScale(float scale) {
+    sScale = std::clamp(scale, DYNRES_MIN_SCALE, 1.0f);
+    sSceneW = std::max(1, (int)std::lround(SCREEN_WIDTH * sScale));
+    sSceneH = std::max(1, (int)std::lround(SCREEN_HEIGHT * sScale));
+    sLowestScale = std::min(sLowestScale, sScale);
+}
+
+// Viewport in target pixels first (at scale 1), then the scale that maps the game's
+// coordinates onto it; nullptr destination rects then cover exactly the used area
+void applySceneTransform(SDL_Renderer* renderer) {
+    SDL_RenderSetScale(renderer, 1.0f, 1.0f);
+    SDL_Rect viewport = { 0, 0, sSceneW, sSceneH };
+    SDL_RenderSetViewport(renderer, &viewport);
+    SDL_RenderSetScale(renderer, (float)sSceneW / SCREEN_WIDTH, (float)sSceneH / SCREEN_HEIGHT);
+}
+
+} // namespace
+
+// --- Public Interface ---
+void initDynamicResolution(SDL_Renderer* renderer, double targetFrameMs, float fixedScale) {
+    closeDynamicResolution();
+    SDL_RenderSetLogicalSize(renderer, SCREEN_WIDTH, SCREEN_HEIGHT); // Resized and fullscreen windows letterbox
+    if (SDL_RenderTargetSupported(renderer) == SDL_TRUE) {
+        sScene = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_TARGET, SCREEN_WIDTH, SCREEN_HEIGHT);
+    }
+    if (!sScene) {
+        std::cerr << "WARNING: Dynamic resolution unavailable, rendering at full size. SDL Error: " << SDL_GetError() << std::endl;
+        return;
+    }
+    SDL_SetTextureBlendMode(sScene, SDL_BLENDMODE_NONE);
+    SDL_SetTextureScaleMode(sScene, SDL_ScaleModeLinear);
+    sLowestScale = 1.0f;
+    applyScale(targetFrameMs > 0.0 ? 1.0f : fixedScale);
+    setDynamicResolutionTarget(targetFrameMs);
+    char line[96];
+    if (sDynamic) std::snprintf(line, sizeof(line), " -> Resolution: dynamic, %.1f ms render budget.", sBudgetMs);
+    else std::snprintf(line, sizeof(line), " -> Resolution: fixed at %dx%d.", sSceneW, sSceneH);
+    std::cout << line << std::endl;
+}
+
+void setDynamicResolutionTarget(double targetFrameMs) {
+    sDynamic = sScene && targetFrameMs > 0.0;
+    sBudgetMs = targetFrameMs * DYNRES_BUDGET_FRACTION;
+    sSmoothedMs = 0.0;
+    sCooldown = DYNRES_COOLDOWN_FRAMES;
+}
+
+void beginSceneFrame(SDL_Renderer* renderer) {
+    if (!sScene) return;
+    if (SDL_SetRenderTarget(renderer, sScene) != 0) return; // Draw straight to the backbuffer this frame
+    applySceneTransform(renderer);
+    sSceneActive = true;
+}
+
+void endSceneFrame(SDL_Renderer* renderer) {
+    sFinishedW = sFinishedH = 0;
+    if (sSceneActive) {
+        sSceneActive = false;
+        sFinishedW = sSceneW; // updateDynamicResolution() may change sSceneW before the next frame
+        sFinishedH = sSceneH;
+        SDL_SetRenderTarget(renderer, nullptr); // Back to the logical-size backbuffer
+        Uint8 r, g, b, a; SDL_GetRenderDrawColor(renderer, &r, &g, &b, &a);
+        SDL_SetRenderDrawColor(renderer, 0, 0, 0, 255); // Letterbox bars
+        SDL_RenderClear(renderer);
+        SDL_SetRenderDrawColor(renderer, r, g, b, a);
+        SDL_Rect used = { 0, 0, sSceneW, sSceneH };
+        SDL_RenderCopy(renderer, sScene, &used, nullptr);
+    }
+    SDL_RenderFlush(renderer); // Software renderers rasterize here, so the cost lands in the measurement
+}
+
+void updateDynamicResolution(double workMs) {
+    sFrames++;
+    sScaleSum += sScale;
+    if (!sDynamic) return;
+    sSmoothedMs = sSmoothedMs > 0.0 ? sSmoothedMs * 0.9 + workMs * 0.1 : workMs;
+    if (sCooldown > 0) { sCooldown--; return; }
+
+    float next = sScale;
+    if (sSmoothedMs > sBudgetMs) {
+        next = sScale - DYNRES_SCALE_STEP;
+    } else {
+        float up = std::min(1.0f, sScale + DYNRES_SCALE_STEP);
+        double predictedMs = sSmoothedMs * (up * up) / (sScale * sScale); // Work follows pixel count
+        if (predictedMs < sBudgetMs * DYNRES_RAISE_HEADROOM) next = up;
+    }
+    next = std::clamp(next, DYNRES_MIN_SCALE, 1.0f);
+    if (std::fabs(next - sScale) < 0.001f) return;
+    sSmoothedMs *= (next * next) / (sScale * sScale); // Start from the prediction, not the old resolution's cost
+    applyScale(next);
+    sCooldown = DYNRES_COOLDOWN_FRAMES;
+    sChanges++;
+}
+
+void restoreRenderTarget(SDL_Renderer* renderer, SDL_Texture* previous) {
+    SDL_SetRenderTarget(renderer, previous);
+    if (previous && previous == sScene) applySceneTransform(renderer);
+}
+
+bool readSceneFrame(SDL_Renderer* renderer, void* pixels, int pitch, int& w, int& h) {
+    if (!sScene || sSceneActive || sFinishedW == 0) return false;
+    SDL_Texture* previous = SDL_GetRenderTarget(renderer);
+    if (SDL_SetRenderTarget(renderer, sScene) != 0) return false;
+    SDL_Rect used = { 0, 0, sFinishedW, sFinishedH };
+    bool ok = SDL_RenderReadPixels(renderer, &used, SDL_PIXELFORMAT_ARGB8888, pixels, pitch) == 0;
+    restoreRenderTarget(renderer, previous);
+    w = sFinishedW;
+    h = sFinishedH;
+    return ok;
+}
+
+void toggleFullscreen(SDL_Window* window) {
+    bool fullscreen = (SDL_GetWindowFlags(window) & SDL_WINDOW_FULLSCREEN_DESKTOP) != 0;
+    if (SDL_SetWindowFullscreen(window, fullscreen ? 0 : SDL_WINDOW_FULLSCREEN_DESKTOP) != 0) {
+        std::cerr << "WARNING: Unable to toggle fullscreen! SDL Error: " << SDL_GetError() << std::endl;
+    }
+}
+
+float getResolutionScale() { return sScale; }
+
+void reportDynamicResolution() {
+    if (!sScene || sFrames == 0) return;
+    char line[160];
+    std::snprintf(line, sizeof(line), "Resolution: mean scale %.2f over %d frames, lowest %.2f, %d change(s); final %dx%d.",
+        sScaleSum / sFrames, sFrames, sLowestScale, sChanges, sSceneW, sSceneH);
+    std::cout << line << std::endl;
+}
+
+void closeDynamicResolution() {
+    if (sScene) { SDL_DestroyTexture(sScene); sScene = nullptr; }
+    sSceneActive = false;
+    sFinishedW = sFinishedH = 0;
+    sDynamic = false;
+    sFrames = 0;
+    sChanges = 0;
+    sScaleSum = 0.0;
+    applyScale(1.0f);
+}
@@ -0,0 +1,40 @@
+#ifndef RESOLUTION_H
+#define RESOLUTION_H
+
+#include <SDL.h>
+
+// Dynamic Resolution
+// The game keeps drawing in SCREEN_WIDTH x SCREEN_HEIGHT coordinates, but into an
+// offscreen render target. Render scale and viewport shrink that space onto the
+// target's top-left w x h pixels, and the result is upscaled to the backbuffer.
+// The backbuffer has a logical size, so the window can be resized or made
+// fullscreen with letterboxing.
+//
+// A controller watches each frame's render work: renderGame() through the upscale,
+// flushed so software rasterization is included. It lowers the scale when the
+// smoothed work time exceeds the frame budget. It raises the scale when the
+// predicted cost at the next step (work scales with pixel count) still fits. Slow
+// machines then lose resolution instead of frame rate.
+//
+// Code that switches render targets mid-frame must go back with
+// restoreRenderTarget(): SDL resets scale and viewport on every target switch.
+
+// targetFrameMs <= 0: fixed scale (fixedScale); also the fallback without render targets
+void initDynamicResolution(SDL_Renderer* renderer, double targetFrameMs, float fixedScale);
+void setDynamicResolutionTarget(double targetFrameMs); // Follow --fps changes
+
+void beginSceneFrame(SDL_Renderer* renderer);   // Before renderGame()
+void endSceneFrame(SDL_Renderer* renderer);     // After renderGame(): upscale to the backbuffer and flush
+void updateDynamicResolution(double workMs);    // Frame start to the end of endSceneFrame()
+void restoreRenderTarget(SDL_Renderer* renderer, SDL_Texture* previous);
+// After SDL_RenderPresent: reads the last finished scene (w x h, before the upscale)
+// as ARGB8888 into pixels, which must hold SCREEN_WIDTH x SCREEN_HEIGHT. false when
+// that frame was drawn straight to the backbuffer (no render targets).
+bool readSceneFrame(SDL_Renderer* renderer, void* pixels, int pitch, int& w, int& h);
+
+void toggleFullscreen(SDL_Window* window);
+float getResolutionScale();
+void reportDynamicResolution();
+void closeDynamicResolution();
+
+#endif // RESOLUTION_H
@@ -0,0 +1,136 @@
+#include <SDL.h>
+#include <iostream>
+#include <algorithm>
+#include <cmath>
+
+#include "config.h"
+#include "road.h"
+#include "resolution.h"
+
+// --- Road Lookup Table ---
+namespace {
+
+struct RoadScanline {
+    SDL_Rect src;
+    SDL_Rect dst; // Relative to the top of the road (y = 0 .. ROAD_HEIGHT-1)
+};
+
+RoadScanline sScanlines[ROAD_HEIGHT];
+SDL_Texture* sRoadTexture = nullptr;  // Source texture (owned by the caller)
+SDL_Texture* sBakedRoad = nullptr;    // SCREEN_WIDTH x ROAD_HEIGHT render target
+bool sBakedValid = false;
+bool sTargetsSupported = false;
+
+void buildScanlineTable(int roadTexW, int roadTexH) {
+    float world_segment_depth_for_texture_map = (float)roadTexH;
+    for (int y_iter = 0; y_iter < ROAD_HEIGHT; ++y_iter) {
+        float norm_y_on_segment = (ROAD_HEIGHT <= 1) ? 1.0f : (float)y_iter / (ROAD_HEIGHT - 1.0f);
+        float current_width_scale = ROAD_PERSPECTIVE_FAR_SCALE + norm_y_on_segment * (ROAD_PERSPECTIVE_NEAR_SCALE - ROAD_PERSPECTIVE_FAR_SCALE);
+        int scanline_on_screen_width = (int)(SCREEN_WIDTH * current_width_scale);
+        int scanline_on_screen_x = (SCREEN_WIDTH - scanline_on_screen_width) / 2;
+        float texture_v_normalized = powf(norm_y_on_segment, ROAD_TEXTURE_V_POWER);
+        int src_v = (int)(ROAD_TEXTURE_V_START_OFFSET + texture_v_normalized * world_segment_depth_for_texture_map);
+        src_v = std::max(0, std::min(src_v, roadTexH - 1));
+        sScanlines[y_iter].src = { 0, src_v, roadTexW, 1 };
+        sScanlines[y_iter].dst = { scanline_on_screen_x, y_iter, scanline_on_screen_width, 1 };
+    }
+}
+
+int drawScanlinesFromTable(SDL_Renderer* renderer, int offsetY) {
+    int calls = 0;
+    for (int i = 0; i < ROAD_HEIGHT; ++i) {
+        SDL_Rect dst = sScanlines[i].dst;
+        if (dst.w <= 0) continue;
+        dst.y += offsetY;
+        SDL_RenderCopy(renderer, sRoadTexture, &sScanlines[i].src, &dst);
+        calls++;
+    }
+    return calls;
+}
+
+bool bakeRoad(SDL_Renderer* renderer) {
+    if (!sBakedRoad) {
+        sBakedRoad = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_TARGET, SCREEN_WIDTH, ROAD_HEIGHT);
+        if (!sBakedRoad) { std::cerr << "WARNING: Unable to create baked road texture! SDL Error: " << SDL_GetError() << std::endl; return false; }
+        SDL_SetTextureBlendMode(sBakedRoad, SDL_BLENDMODE_BLEND);
+    }
+    SDL_Texture* previousTarget = SDL_GetRenderTarget(renderer);
+    if (SDL_SetRenderTarget(renderer, sBakedRoad) != 0) { std::cerr << "WARNING: Unable to bake road! SDL Error: " << SDL_GetError() << std::endl; return false; }
+    Uint8 r, g, b, a; SDL_GetRenderDrawColor(renderer, &r, &g, &b, &a);
+    SDL_SetRenderDrawColor(renderer, 0, 0, 0, 0);
+    SDL_RenderClear(renderer);
+    SDL_SetRenderDrawColor(renderer, r, g, b, a);
+    drawScanlinesFromTable(renderer, 0);
+    restoreRenderTarget(renderer, previousTarget);
+    sBakedValid = true;
+    return true;
+}
+
+} // namespace
+
+// --- Public Interface ---
+bool initRoadRenderer(SDL_Texture* roadTexture, SDL_Renderer* renderer) {
+    closeRoadRenderer();
+    if (!roadTexture || !renderer || ROAD_HEIGHT <= 0) return false;
+    int roadTexW, roadTexH;
+    if (SDL_QueryTexture(roadTexture, nullptr, nullptr, &roadTexW, &roadTexH) != 0 || roadTexW <= 0 || roadTexH <= 0) return false;
+    sRoadTexture = roadTexture;
+    buildScanlineTable(roadTexW, roadTexH);
+    sTargetsSupported = SDL_RenderTargetSupported(renderer) == SDL_TRUE;
+    if (sTargetsSupported) bakeRoad(renderer);
+    return true;
+}
+
+int renderRoad(SDL_Renderer* renderer) {
+    if (!sRoadTexture) return 0;
+    if (sTargetsSupported && !sBakedValid) bakeRoad(renderer);
+    if (sBakedValid) {
+        SDL_Rect dst = { 0, ROAD_Y, SCREEN_WIDTH, ROAD_HEIGHT };
+        SDL_RenderCopy(renderer, sBakedRoad, nullptr, &dst);
+        return 1;
+    }
+    return drawScanlinesFromTable(renderer, ROAD_Y); // No render targets: still skip the per-frame powf
+}
+
+void invalidateRoadCache() {
+    sBakedValid = false;
+}
+
+void closeRoadRenderer() {
+    if (sBakedRoad) { SDL_DestroyTexture(sBakedRoad); sBakedRoad = nullptr; }
+    sBakedValid = false;
+    sRoadTexture = nullptr;
+}
+
+void renderRoadScanlines(SDL_Texture* roadTexture, SDL_Renderer* renderer) {
+    if (roadTexture && ROAD_HEIGHT > 0) {
+        int roadTexW, roadTexH;
+        SDL_QueryTexture(roadTexture, nullptr, nullptr, &roadTexW, &roadTexH);
+
+        if (roadTexW > 0 && roadTexH > 0) {
+            float world_segment_depth_for_texture_map = (float)roadTexH;
+
+            for (int y_iter = 0; y_iter < ROAD_HEIGHT; ++y_iter) {
+                float screen_y_on_road_segment = ROAD_Y + y_iter;
+                float norm_y_on_segment = (float)y_iter / (ROAD_HEIGHT - 1.0f);
+                if (ROAD_HEIGHT <= 1) norm_y_on_segment = 1.0f;
+
+                float current_width_scale = ROAD_PERSPECTIVE_FAR_SCALE + norm_y_on_segment * (ROAD_PERSPECTIVE_NEAR_SCALE - ROAD_PERSPECTIVE_FAR_SCALE);
+                int scanline_on_screen_width = (int)(SCREEN_WIDTH * current_width_scale);
+                int scanline_on_screen_x = (SCREEN_WIDTH - scanline_on_screen_width) / 2;
+
+                float texture_v_normalized = powf(norm_y_on_segment, ROAD_TEXTURE_V_POWER);
+                int src_v = (int)(ROAD_TEXTURE_V_START_OFFSET + texture_v_normalized * world_segment_depth_for_texture_map);
+
+                src_v = std::max(0, std::min(src_v, roadTexH - 1));
+
+                SDL_Rect srcRectScanline = {0, src_v, roadTexW, 1};
+                SDL_Rect destRectScanline = {scanline_on_screen_x, (int)screen_y_on_road_segment, scanline_on_screen_width, 1};
+
+                if (destRectScanline.w > 0) {
+                    SDL_RenderCopy(renderer, roadTexture, &srcRectScanline, &destRectScanline);
+                }
+            }
+        }
+    }
+}
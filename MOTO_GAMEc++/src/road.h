@@ -0,0 +1,20 @@
+#ifndef ROAD_H
+#define ROAD_H
+
+#include <SDL.h>
+
+// Perspective Road Renderer
+// The ROAD_PERSPECTIVE_* constants never change at runtime, so the per-scanline
+// source rows and widths are computed once into a lookup table and the whole road
+// is baked into a render-target texture. A frame then costs a single copy.
+
+bool initRoadRenderer(SDL_Texture* roadTexture, SDL_Renderer* renderer);
+int renderRoad(SDL_Renderer* renderer); // Returns the draw calls issued
+void invalidateRoadCache(); // Call on SDL_RENDER_TARGETS_RESET / SDL_RENDER_DEVICE_RESET
+void closeRoadRenderer();
+
+// Original per-frame scanline path (one powf + one SDL_RenderCopy per row).
+// Kept as the reference for bench/road_bench.cpp.
+void renderRoadScanlines(SDL_Texture* roadTexture, SDL_Renderer* renderer);
+
+#endif // ROAD_H
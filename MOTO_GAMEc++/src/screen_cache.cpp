@@ -0,0 +1,89 @@
+#include <SDL.h>
+#include <iostream>
+
+#include "config.h"
+#include "assets.h"
+#include "profiler.h"
+#include "screen_cache.h"
+#include "resolution.h"
+
+// --- Cached Screen ---
+namespace {
+
+SDL_Texture* sScreen = nullptr;     // SCREEN_WIDTH x SCREEN_HEIGHT render target
+bool sTargetsUnavailable = false;   // Creation failed once: compose straight to the backbuffer
+GameState sCachedState = GameState::EXIT;
+bool sCacheValid = false;
+GameState sShownState = GameState::EXIT; // Last static frame handed to SDL_RenderPresent
+bool sShown = false;
+bool sComposing = false;
+SDL_Texture* sPreviousTarget = nullptr;
+
+bool ensureScreenTexture(SDL_Renderer* renderer) {
+    if (sScreen) return true;
+    if (sTargetsUnavailable) return false;
+    if (SDL_RenderTargetSupported(renderer) == SDL_TRUE) {
+        sScreen = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_TARGET, SCREEN_WIDTH, SCREEN_HEIGHT);
+    }
+    if (!sScreen) {
+        std::cerr << "WARNING: Static screen cache unavailable, redrawing on every change instead." << std::endl;
+        sTargetsUnavailable = true;
+        return false;
+    }
+    SDL_SetTextureBlendMode(sScreen, SDL_BLENDMODE_NONE); // Opaque full-screen copy
+    return true;
+}
+
+// Screens composed while assets still stream in may be missing sprites: never idle on those
+void markShown(GameState state) {
+    sShownState = state;
+    sShown = isAssetLoadingComplete();
+}
+
+} // namespace
+
+// --- Public Interface ---
+bool isStaticScreenState(GameState state) {
+    return state == GameState::ABOUT || state == GameState::CHARACTER_SELECT || state == GameState::WIN || state == GameState::LOSE;
+}
+
+bool beginStaticScreen(SDL_Renderer* renderer, GameState state) {
+    if (sCacheValid && sCachedState == state) {
+        SDL_RenderCopy(renderer, sScreen, nullptr, nullptr);
+        countDrawCalls();
+        markShown(state);
+        return true;
+    }
+    sCacheValid = false;
+    sCachedState = state;
+    if (!ensureScreenTexture(renderer)) return false;
+    sPreviousTarget = SDL_GetRenderTarget(renderer);
+    if (SDL_SetRenderTarget(renderer, sScreen) != 0) { std::cerr << "WARNING: Unable to compose static screen! SDL Error: " << SDL_GetError() << std::endl; return false; }
+    sComposing = true;
+    return false;
+}
+
+int endStaticScreen(SDL_Renderer* renderer) {
+    markShown(sCachedState);
+    if (!sComposing) return 0;
+    sComposing = false;
+    restoreRenderTarget(renderer, sPreviousTarget);
+    SDL_RenderCopy(renderer, sScreen, nullptr, nullptr);
+    sCacheValid = sShown;
+    return 1;
+}
+
+void invalidateStaticScreen() {
+    sCacheValid = false;
+    sShown = false;
+}
+
+bool isStaticScreenIdle(GameState state) {
+    return sShown && sShownState == state && isStaticScreenState(state) && !isProfilerOverlayVisible();
+}
+
+void closeStaticScreenCache() {
+    if (sScreen) { SDL_DestroyTexture(sScreen); sScreen = nullptr; }
+    sTargetsUnavailable = false;
+    invalidateStaticScreen();
+}
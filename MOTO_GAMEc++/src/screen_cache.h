@@ -0,0 +1,28 @@
+#ifndef SCREEN_CACHE_H
+#define SCREEN_CACHE_H
+
+#include <SDL.h>
+#include "types.h"
+
+// Static Screen Cache
+// ABOUT, CHARACTER_SELECT, WIN and LOSE only change on input. renderGame() composes
+// them once into a SCREEN_WIDTH x SCREEN_HEIGHT render target and afterwards just
+// copies it. Once that frame has been presented the screen is idle: the main loop
+// blocks in SDL_WaitEventTimeout and skips render/present until an event calls
+// invalidateStaticScreen(). Every other state is never cached, so MENU animation
+// and PLAYING are unaffected.
+
+bool isStaticScreenState(GameState state);
+
+// true: the cached frame was copied, skip drawing. false: draw the screen as usual
+// (into the cache target when available), then call endStaticScreen().
+bool beginStaticScreen(SDL_Renderer* renderer, GameState state);
+int endStaticScreen(SDL_Renderer* renderer); // Returns the draw calls issued
+
+// Explicit invalidation: call when an input changes what a static screen shows
+// (state changes are picked up automatically), and on window/render resets.
+void invalidateStaticScreen();
+bool isStaticScreenIdle(GameState state); // Nothing to render or present this frame
+void closeStaticScreenCache();
+
+#endif // SCREEN_CACHE_H
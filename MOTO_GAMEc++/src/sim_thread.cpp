@@ -0,0 +1,149 @@
+#include <SDL.h>
+#include <algorithm>
+#include <atomic>
+#include <iostream>
+#include <system_error>
+#include <thread>
+
+#include "config.h"
+#include "functions.h"
+#include "sim_thread.h"
+
+// --- Input Queue (single producer: event thread, single consumer: simulation) ---
+namespace {
+
+struct SimInput {
+    Uint8 bits;
+    bool pressed;
+    Uint64 stamp;
+};
+
+const unsigned SIM_INPUT_QUEUE_SIZE = 256; // Power of two; far more than one tick's worth of key events
+SimInput sInputRing[SIM_INPUT_QUEUE_SIZE];
+std::atomic<unsigned> sInputHead{ 0 }; // Written by the producer
+std::atomic<unsigned> sInputTail{ 0 }; // Written by the consumer
+
+bool popInput(SimInput& input) {
+    unsigned tail = sInputTail.load(std::memory_order_relaxed);
+    if (tail == sInputHead.load(std::memory_order_acquire)) return false;
+    input = sInputRing[tail % SIM_INPUT_QUEUE_SIZE];
+    sInputTail.store(tail + 1, std::memory_order_release);
+    return true;
+}
+
+// --- Snapshot Triple Buffer ---
+// sShared holds the index of the middle slot, plus SNAPSHOT_FRESH while the reader
+// has not picked it up yet. Writer and reader each own one other slot and swap
+// theirs with the middle one in a single atomic exchange.
+const int SNAPSHOT_INDEX_MASK = 3;
+const int SNAPSHOT_FRESH = 4;
+SimSnapshot sSlots[3];
+std::atomic<int> sShared{ 1 };
+int sWriteSlot = 0; // Simulation thread only
+int sReadSlot = 2;  // Render thread only
+
+void publishSnapshot(const World& world, Uint64 tick, Uint64 inputStamp) {
+    SimSnapshot& slot = sSlots[sWriteSlot];
+    copyWorld(slot.world, world);
+    slot.ghost = getGhostPose();
+    slot.tick = tick;
+    slot.inputStamp = inputStamp;
+    slot.publishedAt = SDL_GetPerformanceCounter();
+    sWriteSlot = sShared.exchange(sWriteSlot | SNAPSHOT_FRESH, std::memory_order_acq_rel) & SNAPSHOT_INDEX_MASK;
+}
+
+// --- Thread ---
+std::thread sThread;
+std::atomic<bool> sStopRequested{ false };
+std::atomic<bool> sLoopRunning{ false }; // The thread can finish before the render thread joins it
+Uint64 sTickPeriod = 1; // Performance counter ticks per simulation tick
+
+void simulationLoop(World* world, int tickRate) {
+    const float simDt = 1.0f / tickRate;
+    Uint64 nextTick = SDL_GetPerformanceCounter();
+    Uint64 tick = 0;
+    Uint64 inputStamp = 0;
+    while (!sStopRequested.load(std::memory_order_acquire)) {
+        Uint64 now = SDL_GetPerformanceCounter();
+        if (now < nextTick) {
+            Uint32 waitMs = (Uint32)((nextTick - now) * 1000 / SDL_GetPerformanceFrequency());
+            if (waitMs > 1) SDL_Delay(waitMs - 1); // Sleep most of the gap, then yield to the deadline
+            else std::this_thread::yield();
+            continue;
+        }
+        if (now - nextTick > sTickPeriod * SIM_MAX_TICKS_PER_FRAME) nextTick = now; // Catch-up cap: drop time rather than spiral
+
+        SimInput input;
+        while (popInput(input)) {
+            if (input.pressed) world->input |= input.bits;
+            else world->input &= (Uint8)~input.bits;
+            inputStamp = std::max(inputStamp, input.stamp);
+        }
+        storeWorldPositions(*world);
+        tickSession(*world, simDt);
+        nextTick += sTickPeriod;
+        publishSnapshot(*world, ++tick, inputStamp);
+        if (!isSessionState(world->state)) break; // The render thread picks up the outcome and joins
+    }
+    sLoopRunning.store(false, std::memory_order_release);
+}
+
+} // namespace
+
+// --- Public Interface ---
+bool startSimulationThread(World& world, int tickRate) {
+    stopSimulationThread();
+    for (SimSnapshot& slot : sSlots) { // Everything readable before the first tick
+        copyWorld(slot.world, world);
+        slot.ghost = getGhostPose();
+        slot.tick = 0;
+        slot.inputStamp = 0;
+        slot.publishedAt = SDL_GetPerformanceCounter();
+    }
+    sShared.store(1, std::memory_order_relaxed);
+    sWriteSlot = 0;
+    sReadSlot = 2;
+    sInputHead.store(0, std::memory_order_relaxed);
+    sInputTail.store(0, std::memory_order_relaxed);
+    sTickPeriod = std::max<Uint64>(1, SDL_GetPerformanceFrequency() / tickRate);
+    sStopRequested.store(false, std::memory_order_release);
+    sLoopRunning.store(true, std::memory_order_release);
+    try {
+        sThread = std::thread(simulationLoop, &world, tickRate);
+    } catch (const std::system_error& e) {
+        std::cerr << "WARNING: Unable to start the simulation thread (" << e.what() << "), simulating on the main thread." << std::endl;
+        sLoopRunning.store(false, std::memory_order_release);
+        return false;
+    }
+    return true;
+}
+
+void stopSimulationThread() {
+    if (!sThread.joinable()) return;
+    sStopRequested.store(true, std::memory_order_release);
+    sThread.join();
+}
+
+bool isSimulationThreadRunning() { return sThread.joinable(); }
+
+void sendSimulationInput(Uint8 inputBits, bool pressed, Uint64 stamp) {
+    unsigned head = sInputHead.load(std::memory_order_relaxed);
+    while (head - sInputTail.load(std::memory_order_acquire) >= SIM_INPUT_QUEUE_SIZE) {
+        if (!sLoopRunning.load(std::memory_order_acquire)) return; // Session over: nobody will drain it
+        std::this_thread::yield(); // Full: the next tick drains it
+    }
+    sInputRing[head % SIM_INPUT_QUEUE_SIZE] = { inputBits, pressed, stamp };
+    sInputHead.store(head + 1, std::memory_order_release);
+}
+
+const SimSnapshot& acquireSimSnapshot() {
+    if (sShared.load(std::memory_order_acquire) & SNAPSHOT_FRESH) {
+        sReadSlot = sShared.exchange(sReadSlot, std::memory_order_acq_rel) & SNAPSHOT_INDEX_MASK;
+    }
+    return sSlots[sReadSlot];
+}
+
+float getSnapshotAlpha(const SimSnapshot& snapshot) {
+    float alpha = (float)(SDL_GetPerformanceCounter() - snapshot.publishedAt) / (float)sTickPeriod;
+    return std::min(1.0f, std::max(0.0f, alpha));
+}
@@ -0,0 +1,36 @@
+#ifndef SIM_THREAD_H
+#define SIM_THREAD_H
+
+#include <SDL.h>
+#include "world.h"
+#include "replay.h" // GhostPose
+
+// Simulation Thread
+// PLAYING and WIN_DELAY tick on their own thread at the fixed tick rate, so a slow
+// present or text upload no longer delays the simulation. While it runs the thread
+// owns the World it was started with; the main thread must not touch it until
+// stopSimulationThread() has joined.
+//   - Input: key presses/releases go through a lock-free SPSC ring and are applied
+//     at the start of the next tick, with their latency stamps.
+//   - Output: after every tick the thread publishes a snapshot into a lock-free
+//     triple buffer. The renderer always gets the newest complete snapshot, neither
+//     side ever waits, and no slot is written while it is being read.
+// The thread stops by itself once the world leaves PLAYING/WIN_DELAY.
+
+struct SimSnapshot {
+    World world;
+    GhostPose ghost;
+    Uint64 tick;        // Ticks since the session started
+    Uint64 inputStamp;  // Newest input stamp applied up to this tick (latency.h)
+    Uint64 publishedAt; // SDL_GetPerformanceCounter() when the tick finished
+};
+
+bool startSimulationThread(World& world, int tickRate); // false: run the session on the caller's thread
+void stopSimulationThread(); // Joins; a no-op when not running
+bool isSimulationThreadRunning();
+
+void sendSimulationInput(Uint8 inputBits, bool pressed, Uint64 stamp); // RunInputBits; stamp from latency.h
+const SimSnapshot& acquireSimSnapshot(); // Newest snapshot; valid until the next call (render thread only)
+float getSnapshotAlpha(const SimSnapshot& snapshot); // Interpolation fraction by time since publish
+
+#endif // SIM_THREAD_H
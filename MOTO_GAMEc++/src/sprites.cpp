@@ -0,0 +1,267 @@
+#include <SDL.h>
+#include <algorithm>
+#include <functional>
+#include <iostream>
+#include <utility>
+#include <vector>
+
+#include "config.h"
+#include "sprites.h"
+#include "profiler.h"
+
+// --- Atlas State ---
+namespace {
+
+const int ATLAS_PADDING = 2;
+const int PREFERRED_ATLAS_WIDTH = 2048;
+const int ATLAS_SIZE_LIMIT = 4096; // Upper bound even when the renderer allows more
+const int MAX_ATLAS_PAGES = 4;     // Per group
+
+struct SpriteEntry {
+    SDL_Texture** page; // Slot in sAtlasPages; nulled when the group is evicted (assets.h)
+    SDL_Rect src;
+    float u0, v0, u1, v1;
+};
+
+// Sprites of one group wait here until the whole group has been decoded
+struct PendingAtlas {
+    int expected = 0; // Sprites queued in the group; a reload delivers them all again
+    std::vector<std::pair<SpriteId, SDL_Surface*>> surfaces;
+};
+
+SpriteEntry sSprites[(int)SpriteId::COUNT] = {};
+SDL_Point sMaskSize[(int)SpriteId::COUNT] = {}; // Drawn size of sprites that want a mask; 0 x 0: none
+CollisionMask sMasks[(int)SpriteId::COUNT];
+PendingAtlas sPending[(int)AssetGroup::COUNT];
+SDL_Texture* sAtlasPages[(int)AssetGroup::COUNT][MAX_ATLAS_PAGES] = {}; // Owned by the texture registry
+
+struct SpriteCommand {
+    SDL_Texture* texture; // nullptr for solid rects
+    SDL_Rect dst;
+    float u0, v0, u1, v1;
+    SDL_Color color;
+    int layer;
+};
+
+std::vector<SpriteCommand> sCommands; // Capacity is kept between frames
+std::vector<SDL_Vertex> sVertices;
+std::vector<int> sIndices;
+int sLastBatchCount = 0;
+
+struct PlacedSprite {
+    SpriteId id;
+    SDL_Surface* surface;
+    int page;
+    SDL_Rect rect;
+};
+
+bool uploadAtlasPage(SDL_Renderer* renderer, AssetGroup group, const std::vector<PlacedSprite>& placed, int page, int pageW, int pageH) {
+    if (page >= MAX_ATLAS_PAGES) { std::cerr << "WARNING: Sprite atlas needs more than " << MAX_ATLAS_PAGES << " pages; the rest is skipped." << std::endl; return false; }
+    SDL_Surface* atlas = SDL_CreateRGBSurfaceWithFormat(0, pageW, pageH, 32, SDL_PIXELFORMAT_RGBA32);
+    if (!atlas) { std::cerr << "ERROR: Unable to create sprite atlas surface! SDL Error: " << SDL_GetError() << std::endl; return false; }
+    SDL_FillRect(atlas, nullptr, 0);
+    for (const auto& p : placed) {
+        if (p.page != page) continue;
+        SDL_Rect dst = p.rect;
+        SDL_SetSurfaceBlendMode(p.surface, SDL_BLENDMODE_NONE); // Copy alpha as-is
+        SDL_BlitSurface(p.surface, nullptr, atlas, &dst);
+    }
+    SDL_Texture* texture = SDL_CreateTextureFromSurface(renderer, atlas);
+    SDL_FreeSurface(atlas);
+    if (!texture) { std::cerr << "ERROR: Unable to create sprite atlas texture! SDL Error: " << SDL_GetError() << std::endl; return false; }
+    SDL_SetTextureBlendMode(texture, SDL_BLENDMODE_BLEND);
+    SDL_Texture** slot = &sAtlasPages[(int)group][page];
+    if (*slot) SDL_DestroyTexture(*slot);
+    *slot = texture;
+    registerGroupTexture(slot, group);
+
+    for (const auto& p : placed) {
+        if (p.page != page) continue;
+        SpriteEntry& e = sSprites[(int)p.id];
+        e.page = slot;
+        e.src = p.rect;
+        e.u0 = (float)p.rect.x / pageW;
+        e.v0 = (float)p.rect.y / pageH;
+        e.u1 = (float)(p.rect.x + p.rect.w) / pageW;
+        e.v1 = (float)(p.rect.y + p.rect.h) / pageH;
+    }
+    return true;
+}
+
+// Only from the first delivery: after that the simulation thread may be reading the mask
+void buildSpriteMask(SpriteId id, SDL_Surface* surface) {
+    CollisionMask& mask = sMasks[(int)id];
+    const SDL_Point size = sMaskSize[(int)id];
+    if (size.x <= 0 || mask.w > 0) return;
+    if (surface->w != size.x || surface->h != size.y) { // The loader could not pre-scale it: a mask at this size would not fit the sprite
+        std::cerr << "WARNING: Sprite " << (int)id << " loaded at " << surface->w << "x" << surface->h << ", not its drawn " << size.x << "x" << size.y
+                  << "; no collision mask, it collides as a box." << std::endl;
+        return;
+    }
+    SDL_Surface* argb = surface->format->format == SDL_PIXELFORMAT_ARGB8888 ? surface : SDL_ConvertSurfaceFormat(surface, SDL_PIXELFORMAT_ARGB8888, 0);
+    if (!argb || SDL_LockSurface(argb) != 0) {
+        std::cerr << "WARNING: No collision mask for sprite " << (int)id << ", it collides as a box. SDL Error: " << SDL_GetError() << std::endl;
+    } else {
+        // Alpha is the high byte of each 32-bit pixel
+        const Uint8* alpha = static_cast<const Uint8*>(argb->pixels) + (SDL_BYTEORDER == SDL_LIL_ENDIAN ? 3 : 0);
+        buildCollisionMask(mask, alpha, argb->w, argb->h, argb->pitch, 4, COLLISION_ALPHA_THRESHOLD);
+        SDL_UnlockSurface(argb);
+    }
+    if (argb && argb != surface) SDL_FreeSurface(argb);
+}
+
+// Shelf-packs one group's sprites (tallest first) into as many pages as needed
+void packAtlas(AssetGroup group, SDL_Renderer* renderer) {
+    PendingAtlas& pending = sPending[(int)group];
+    SDL_RendererInfo info;
+    int maxSize = ATLAS_SIZE_LIMIT;
+    if (SDL_GetRendererInfo(renderer, &info) == 0 && info.max_texture_width > 0) {
+        maxSize = std::min(maxSize, std::min(info.max_texture_width, info.max_texture_height));
+    }
+
+    std::vector<PlacedSprite> placed;
+    for (auto& entry : pending.surfaces) {
+        if (!entry.second) continue;
+        buildSpriteMask(entry.first, entry.second);
+        placed.push_back({ entry.first, entry.second, 0, { 0, 0, entry.second->w, entry.second->h } });
+    }
+    std::stable_sort(placed.begin(), placed.end(), [](const PlacedSprite& a, const PlacedSprite& b) { return a.rect.h > b.rect.h; });
+
+    int pageW = PREFERRED_ATLAS_WIDTH;
+    for (const auto& p : placed) pageW = std::max(pageW, p.rect.w + 2 * ATLAS_PADDING);
+    pageW = std::min(pageW, maxSize);
+
+    std::vector<int> pageHeights(1, 0);
+    int page = 0, penX = ATLAS_PADDING, penY = ATLAS_PADDING, shelfH = 0;
+    for (auto& p : placed) {
+        if (p.rect.w + 2 * ATLAS_PADDING > pageW || p.rect.h + 2 * ATLAS_PADDING > maxSize) {
+            std::cerr << "WARNING: Sprite " << (int)p.id << " (" << p.rect.w << "x" << p.rect.h << ") exceeds the max texture size and is skipped." << std::endl;
+            p.page = -1;
+            continue;
+        }
+        if (penX + p.rect.w + ATLAS_PADDING > pageW) { penX = ATLAS_PADDING; penY += shelfH + ATLAS_PADDING; shelfH = 0; }
+        if (penY + p.rect.h + ATLAS_PADDING > maxSize) { ++page; pageHeights.push_back(0); penX = ATLAS_PADDING; penY = ATLAS_PADDING; shelfH = 0; }
+        p.page = page;
+        p.rect.x = penX;
+        p.rect.y = penY;
+        penX += p.rect.w + ATLAS_PADDING;
+        shelfH = std::max(shelfH, p.rect.h);
+        pageHeights[page] = std::max(pageHeights[page], penY + p.rect.h + ATLAS_PADDING);
+    }
+
+    for (int i = 0; i <= page; ++i) {
+        if (pageHeights[i] > 0) uploadAtlasPage(renderer, group, placed, i, pageW, pageHeights[i]);
+    }
+    for (auto& entry : pending.surfaces) if (entry.second) SDL_FreeSurface(entry.second);
+    pending.surfaces.clear();
+}
+
+void ensureQuadIndices(size_t quadCount) {
+    size_t have = sIndices.size() / 6;
+    if (have >= quadCount) return;
+    sIndices.reserve(quadCount * 6);
+    for (size_t q = have; q < quadCount; ++q) {
+        int base = (int)(q * 4);
+        int idx[6] = { base, base + 1, base + 2, base + 2, base + 1, base + 3 };
+        sIndices.insert(sIndices.end(), idx, idx + 6);
+    }
+}
+
+void pushCommand(SDL_Texture* texture, const SDL_Rect& dst, float u0, float v0, float u1, float v1, SDL_Color color, int layer) {
+    sCommands.push_back({ texture, dst, u0, v0, u1, v1, color, layer });
+}
+
+} // namespace
+
+// --- Loading ---
+void queueSpriteLoad(SpriteId id, const std::string& path, AssetGroup group, bool required, AssetSize size, bool collisionMask) {
+    sSprites[(int)id] = {};
+    sMaskSize[(int)id] = collisionMask ? SDL_Point{ size.w, size.h } : SDL_Point{ 0, 0 };
+    PendingAtlas& pending = sPending[(int)group];
+    pending.expected++;
+    queueSurfaceLoad(path, group, required, [id, group](SDL_Surface* surface, SDL_Renderer* renderer) {
+        PendingAtlas& p = sPending[(int)group];
+        p.surfaces.push_back({ id, surface });
+        if ((int)p.surfaces.size() == p.expected) packAtlas(group, renderer);
+    }, size);
+}
+
+bool hasSprite(SpriteId id) { return sSprites[(int)id].page && *sSprites[(int)id].page; }
+
+SDL_Point getSpriteSize(SpriteId id) {
+    if (!hasSprite(id)) return { 0, 0 };
+    const SpriteEntry& e = sSprites[(int)id];
+    return { e.src.w, e.src.h };
+}
+
+const CollisionMask* getSpriteMask(SpriteId id) {
+    const CollisionMask& mask = sMasks[(int)id];
+    return mask.w > 0 ? &mask : nullptr;
+}
+
+void closeSpriteSystem() {
+    for (auto& pages : sAtlasPages) { // Normally already freed by freeGroupTextures()
+        for (auto*& page : pages) if (page) { SDL_DestroyTexture(page); page = nullptr; }
+    }
+    for (auto& pending : sPending) {
+        for (auto& entry : pending.surfaces) if (entry.second) SDL_FreeSurface(entry.second);
+        pending.surfaces.clear();
+        pending.expected = 0;
+    }
+    for (auto& e : sSprites) e = {};
+    for (auto& mask : sMasks) mask = CollisionMask();
+    sCommands.clear();
+}
+
+// --- Batching ---
+void drawSprite(SpriteId id, const SDL_Rect& dst, int layer, SDL_Color tint) {
+    if (!hasSprite(id)) return;
+    const SpriteEntry& e = sSprites[(int)id];
+    pushCommand(*e.page, dst, e.u0, e.v0, e.u1, e.v1, tint, layer);
+}
+
+void drawTextureBatched(SDL_Texture* texture, const SDL_Rect& dst, int layer) {
+    if (!texture) return;
+    pushCommand(texture, dst, 0.0f, 0.0f, 1.0f, 1.0f, { 255, 255, 255, 255 }, layer);
+}
+
+void drawRectBatched(const SDL_Rect& dst, SDL_Color color, int layer) {
+    pushCommand(nullptr, dst, 0.0f, 0.0f, 0.0f, 0.0f, color, layer);
+}
+
+void flushSprites(SDL_Renderer* renderer) {
+    sLastBatchCount = 0;
+    if (sCommands.empty()) return;
+    PROFILE_SCOPE("sprites");
+    std::stable_sort(sCommands.begin(), sCommands.end(), [](const SpriteCommand& a, const SpriteCommand& b) {
+        if (a.layer != b.layer) return a.layer < b.layer;
+        return std::less<SDL_Texture*>()(a.texture, b.texture);
+    });
+
+    size_t runStart = 0;
+    while (runStart < sCommands.size()) {
+        SDL_Texture* texture = sCommands[runStart].texture;
+        size_t runEnd = runStart;
+        sVertices.clear();
+        while (runEnd < sCommands.size() && sCommands[runEnd].texture == texture) {
+            const SpriteCommand& c = sCommands[runEnd];
+            float x0 = (float)c.dst.x, y0 = (float)c.dst.y, x1 = (float)(c.dst.x + c.dst.w), y1 = (float)(c.dst.y + c.dst.h);
+            sVertices.push_back({ { x0, y0 }, c.color, { c.u0, c.v0 } });
+            sVertices.push_back({ { x1, y0 }, c.color, { c.u1, c.v0 } });
+            sVertices.push_back({ { x0, y1 }, c.color, { c.u0, c.v1 } });
+            sVertices.push_back({ { x1, y1 }, c.color, { c.u1, c.v1 } });
+            ++runEnd;
+        }
+        size_t quads = runEnd - runStart;
+        ensureQuadIndices(quads);
+        if (SDL_RenderGeometry(renderer, texture, sVertices.data(), (int)sVertices.size(), sIndices.data(), (int)(quads * 6)) != 0) {
+            std::cerr << "ERROR: Sprite batch failed! SDL Error: " << SDL_GetError() << std::endl;
+        }
+        ++sLastBatchCount;
+        runStart = runEnd;
+    }
+    sCommands.clear();
+    countDrawCalls(sLastBatchCount);
+}
+
+int getLastSpriteBatchCount() { return sLastBatchCount; }
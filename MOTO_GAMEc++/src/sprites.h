@@ -0,0 +1,67 @@
+#ifndef SPRITES_H
+#define SPRITES_H
+
+#include <SDL.h>
+#include <string>
+#include "assets.h"
+#include "collision_mask.h"
+
+// --- Sprite Atlases ---
+// Small sprites are decoded by the asset loader and packed into one atlas texture
+// per AssetGroup (more pages only if the renderer's max texture size is exceeded).
+// Each sprite's source rect and size are cached at pack time. Atlas pages are
+// registered with the texture registry under their group.
+enum class SpriteId {
+    MENU_BG_01,
+    MENU_BG_02,
+    MENU_BG_03,
+    MENU_BG_04,
+    LOGO_01,
+    LOGO_02,
+    LOGO_03,
+    LOGO_04,
+    LOGO_05,
+    CHARACTER_01,
+    CHARACTER_02,
+    PLAYER_MALE,
+    PLAYER_FEMALE,
+    BARRIER_01,
+    BARRIER_02,
+    BARRIER_03,
+    COIN,
+    COUNT
+};
+
+// size: pre-scale to the drawn size (see AssetSize); getSpriteSize() then returns it.
+// collisionMask: also build a 1-bit mask from the pre-scaled alpha (collision_mask.h);
+// needs an exactSize(), and a sprite that does not arrive at that size gets no mask
+void queueSpriteLoad(SpriteId id, const std::string& path, AssetGroup group, bool required = false, AssetSize size = AssetSize(), bool collisionMask = false);
+bool hasSprite(SpriteId id); // false while the group is evicted
+SDL_Point getSpriteSize(SpriteId id); // Stored size in pixels, {0,0} when missing
+// nullptr until decoded, or when the sprite did not arrive at its drawn size (the
+// game then keeps the box fallback). Built once and kept through evictions, so the
+// simulation thread can read it during a session; freed by closeSpriteSystem(). The
+// masks of consecutive ids are consecutive in memory (barrier types index from BARRIER_01).
+const CollisionMask* getSpriteMask(SpriteId id);
+void closeSpriteSystem();
+
+// --- Batched Sprite Renderer ---
+// Draws are recorded into a per-frame command list. flushSprites() stable-sorts it
+// by (layer, texture) and submits one SDL_RenderGeometry call per texture run, so
+// submission order is kept within a layer and texture.
+enum SpriteLayer {
+    LAYER_BACKGROUND = 0,
+    LAYER_GROUND,
+    LAYER_HUD_BACK,
+    LAYER_ENTITIES,
+    LAYER_PLAYER,
+    LAYER_OVERLAY
+};
+
+void drawSprite(SpriteId id, const SDL_Rect& dst, int layer, SDL_Color tint = { 255, 255, 255, 255 }); // Tint alpha fades the sprite
+void drawTextureBatched(SDL_Texture* texture, const SDL_Rect& dst, int layer); // Whole texture
+void drawRectBatched(const SDL_Rect& dst, SDL_Color color, int layer);       // Solid fill
+void flushSprites(SDL_Renderer* renderer);
+int getLastSpriteBatchCount(); // Geometry calls issued by the last flush
+
+#endif // SPRITES_H
@@ -0,0 +1,209 @@
+#include <SDL.h>
+#include <SDL_ttf.h>
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <unordered_map>
+#include <algorithm>
+
+#include "text.h"
+#include "profiler.h"
+#include "frame_arena.h"
+
+// --- Atlas Data ---
+namespace {
+
+const int FIRST_GLYPH = 32;  // ' '
+const int LAST_GLYPH = 126;  // '~'
+const int GLYPH_COUNT = LAST_GLYPH - FIRST_GLYPH + 1;
+const int ATLAS_WIDTH = 512;
+const int ATLAS_PADDING = 1;
+
+struct GlyphInfo {
+    SDL_Rect src;   // Location inside the atlas texture
+    int advance;
+    bool present;
+};
+
+// Quads laid out relative to the string origin (0,0)
+struct CachedString {
+    std::vector<SDL_Vertex> vertices;
+};
+
+TTF_Font* sAtlasFont = nullptr;
+SDL_Texture* sAtlasTexture = nullptr;
+int sAtlasW = 0;
+int sAtlasH = 0;
+GlyphInfo sGlyphs[GLYPH_COUNT];
+
+std::unordered_map<std::string, CachedString> sStringCache;
+std::string sKeyBuffer;                 // Reused to build cache keys without reallocating
+std::vector<SDL_Vertex> sLayoutVertices; // Scratch for dynamic strings
+std::vector<SDL_Vertex> sDrawVertices;   // Scratch for translated vertices
+std::vector<int> sQuadIndices;           // Shared 0,1,2,2,1,3 pattern for every quad
+
+// Legacy path: rasterize the whole string and upload a throwaway texture.
+// Only used when the atlas is unavailable or the string has non-ASCII glyphs.
+bool renderTextUncached(std::string_view text, int x, int y, TTF_Font* font, SDL_Color color, SDL_Renderer* renderer) {
+    SDL_Surface* textSurface = TTF_RenderText_Solid(font, frameString(text).data(), color); // Views need not be NUL-terminated
+    if (textSurface == nullptr) { std::cerr << "ERROR: Unable to render text surface for \"" << text << "\"! SDL_ttf Error: " << TTF_GetError() << std::endl; return false; }
+    SDL_Texture* textTexture = SDL_CreateTextureFromSurface(renderer, textSurface);
+    if (textTexture == nullptr) { std::cerr << "ERROR: Unable to create texture from rendered text! SDL Error: " << SDL_GetError() << std::endl; SDL_FreeSurface(textSurface); return false; }
+    SDL_Rect renderQuad = { x, y, textSurface->w, textSurface->h };
+    SDL_FreeSurface(textSurface);
+    SDL_RenderCopy(renderer, textTexture, nullptr, &renderQuad);
+    countDrawCalls();
+    SDL_DestroyTexture(textTexture);
+    return true;
+}
+
+bool isAtlasCompatible(std::string_view text, TTF_Font* font) {
+    if (sAtlasTexture == nullptr || font != sAtlasFont) return false;
+    for (unsigned char c : text) {
+        if (c < FIRST_GLYPH || c > LAST_GLYPH || !sGlyphs[c - FIRST_GLYPH].present) return false;
+    }
+    return true;
+}
+
+void ensureQuadIndices(size_t quadCount) {
+    size_t have = sQuadIndices.size() / 6;
+    if (have >= quadCount) return;
+    sQuadIndices.reserve(quadCount * 6);
+    for (size_t q = have; q < quadCount; ++q) {
+        int base = (int)(q * 4);
+        int idx[6] = { base, base + 1, base + 2, base + 2, base + 1, base + 3 };
+        sQuadIndices.insert(sQuadIndices.end(), idx, idx + 6);
+    }
+}
+
+// Appends one quad per glyph (origin at 0,0) using cached metrics and kerning.
+void layoutString(std::string_view text, SDL_Color color, std::vector<SDL_Vertex>& out) {
+    out.clear();
+    float invW = 1.0f / sAtlasW, invH = 1.0f / sAtlasH;
+    int penX = 0;
+    Uint16 prev = 0;
+    for (unsigned char c : text) {
+        const GlyphInfo& g = sGlyphs[c - FIRST_GLYPH];
+        if (prev != 0) penX += TTF_GetFontKerningSizeGlyphs(sAtlasFont, prev, c);
+        prev = c;
+        if (g.src.w > 0 && g.src.h > 0) {
+            float x0 = (float)penX, y0 = 0.0f, x1 = (float)(penX + g.src.w), y1 = (float)g.src.h;
+            float u0 = g.src.x * invW, v0 = g.src.y * invH, u1 = (g.src.x + g.src.w) * invW, v1 = (g.src.y + g.src.h) * invH;
+            out.push_back({ { x0, y0 }, color, { u0, v0 } });
+            out.push_back({ { x1, y0 }, color, { u1, v0 } });
+            out.push_back({ { x0, y1 }, color, { u0, v1 } });
+            out.push_back({ { x1, y1 }, color, { u1, v1 } });
+        }
+        penX += g.advance;
+    }
+}
+
+bool drawLayout(const std::vector<SDL_Vertex>& layout, int x, int y, SDL_Renderer* renderer) {
+    if (layout.empty()) return true;
+    sDrawVertices.resize(layout.size());
+    for (size_t i = 0; i < layout.size(); ++i) {
+        sDrawVertices[i] = layout[i];
+        sDrawVertices[i].position.x += x;
+        sDrawVertices[i].position.y += y;
+    }
+    size_t quadCount = layout.size() / 4;
+    ensureQuadIndices(quadCount);
+    if (SDL_RenderGeometry(renderer, sAtlasTexture, sDrawVertices.data(), (int)sDrawVertices.size(), sQuadIndices.data(), (int)(quadCount * 6)) != 0) {
+        std::cerr << "ERROR: Unable to draw text geometry! SDL Error: " << SDL_GetError() << std::endl;
+        return false;
+    }
+    countDrawCalls();
+    return true;
+}
+
+} // namespace
+
+// --- Atlas Construction ---
+bool initTextRenderer(TTF_Font* font, SDL_Renderer* renderer) {
+    closeTextRenderer();
+    if (!font || !renderer) { std::cerr << "ERROR: Cannot build glyph atlas - Font or Renderer is null!" << std::endl; return false; }
+
+    SDL_Color white = { 255, 255, 255, 255 };
+    std::vector<SDL_Surface*> glyphSurfaces(GLYPH_COUNT, nullptr);
+
+    // Shelf-pack every glyph into rows of ATLAS_WIDTH
+    int penX = ATLAS_PADDING, penY = ATLAS_PADDING, shelfH = 0;
+    for (int i = 0; i < GLYPH_COUNT; ++i) {
+        Uint16 ch = (Uint16)(FIRST_GLYPH + i);
+        GlyphInfo& g = sGlyphs[i];
+        g = { { 0, 0, 0, 0 }, 0, false };
+        if (!TTF_GlyphIsProvided(font, ch)) continue;
+        int minx, maxx, miny, maxy, advance;
+        if (TTF_GlyphMetrics(font, ch, &minx, &maxx, &miny, &maxy, &advance) != 0) continue;
+        g.advance = advance;
+        g.present = true;
+        if (ch == ' ') continue; // Nothing to rasterize, only the advance matters
+
+        SDL_Surface* s = TTF_RenderGlyph_Solid(font, ch, white);
+        if (s == nullptr) { std::cerr << "WARNING: Unable to rasterize glyph '" << (char)ch << "'! SDL_ttf Error: " << TTF_GetError() << std::endl; continue; }
+        if (penX + s->w + ATLAS_PADDING > ATLAS_WIDTH) { penX = ATLAS_PADDING; penY += shelfH + ATLAS_PADDING; shelfH = 0; }
+        g.src = { penX, penY, s->w, s->h };
+        penX += s->w + ATLAS_PADDING;
+        shelfH = std::max(shelfH, s->h);
+        glyphSurfaces[i] = s;
+    }
+    sAtlasW = ATLAS_WIDTH;
+    sAtlasH = penY + shelfH + ATLAS_PADDING;
+
+    SDL_Surface* atlas = SDL_CreateRGBSurfaceWithFormat(0, sAtlasW, sAtlasH, 32, SDL_PIXELFORMAT_RGBA32);
+    if (atlas == nullptr) {
+        std::cerr << "ERROR: Unable to create glyph atlas surface! SDL Error: " << SDL_GetError() << std::endl;
+        for (auto* s : glyphSurfaces) if (s) SDL_FreeSurface(s);
+        return false;
+    }
+    SDL_FillRect(atlas, nullptr, 0);
+    for (int i = 0; i < GLYPH_COUNT; ++i) {
+        if (!glyphSurfaces[i]) continue;
+        SDL_Rect dst = sGlyphs[i].src;
+        SDL_BlitSurface(glyphSurfaces[i], nullptr, atlas, &dst); // Colorkeyed background stays transparent
+        SDL_FreeSurface(glyphSurfaces[i]);
+    }
+
+    sAtlasTexture = SDL_CreateTextureFromSurface(renderer, atlas);
+    SDL_FreeSurface(atlas);
+    if (sAtlasTexture == nullptr) { std::cerr << "ERROR: Unable to create glyph atlas texture! SDL Error: " << SDL_GetError() << std::endl; return false; }
+    SDL_SetTextureBlendMode(sAtlasTexture, SDL_BLENDMODE_BLEND);
+    sAtlasFont = font;
+    std::cout << " -> Glyph atlas built (" << sAtlasW << "x" << sAtlasH << ")." << std::endl;
+    return true;
+}
+
+void closeTextRenderer() {
+    if (sAtlasTexture) { SDL_DestroyTexture(sAtlasTexture); sAtlasTexture = nullptr; }
+    sAtlasFont = nullptr;
+    sStringCache.clear();
+}
+
+// --- Drawing ---
+bool renderText(std::string_view text, int x, int y, TTF_Font* font, SDL_Color color, SDL_Renderer* renderer) {
+    PROFILE_SCOPE("text");
+    if (!font) { std::cerr << "ERROR: Cannot render text - Font not loaded!" << std::endl; return false; }
+    if (!renderer) { std::cerr << "ERROR: Cannot render text - Renderer is null!" << std::endl; return false; }
+    if (!isAtlasCompatible(text, font)) return renderTextUncached(text, x, y, font, color, renderer);
+
+    sKeyBuffer.assign(text);
+    sKeyBuffer.push_back('\0');
+    sKeyBuffer.append((const char*)&color, sizeof(color));
+    auto it = sStringCache.find(sKeyBuffer);
+    if (it == sStringCache.end()) {
+        it = sStringCache.emplace(sKeyBuffer, CachedString()).first;
+        layoutString(text, color, it->second.vertices);
+    }
+    return drawLayout(it->second.vertices, x, y, renderer);
+}
+
+bool renderDynamicText(std::string_view text, int x, int y, TTF_Font* font, SDL_Color color, SDL_Renderer* renderer) {
+    PROFILE_SCOPE("text");
+    if (!font) { std::cerr << "ERROR: Cannot render text - Font not loaded!" << std::endl; return false; }
+    if (!renderer) { std::cerr << "ERROR: Cannot render text - Renderer is null!" << std::endl; return false; }
+    if (!isAtlasCompatible(text, font)) return renderTextUncached(text, x, y, font, color, renderer);
+
+    layoutString(text, color, sLayoutVertices);
+    return drawLayout(sLayoutVertices, x, y, renderer);
+}
@@ -0,0 +1,23 @@
+#ifndef TEXT_H
+#define TEXT_H
+
+#include <SDL.h>
+#include <SDL_ttf.h>
+#include <string_view>
+
+// Glyph-atlas text renderer.
+// The printable ASCII glyphs of one font are rasterized once into a single atlas
+// texture; strings are laid out from the cached glyph metrics and drawn with one
+// SDL_RenderGeometry call. Strings drawn through renderText() additionally keep
+// their laid-out quads in a cache keyed by text and color. Both take string views, so
+// literals and frame-arena strings (frame_arena.h) reach them without a heap copy.
+
+bool initTextRenderer(TTF_Font* font, SDL_Renderer* renderer);
+void closeTextRenderer();
+
+// Static strings (menu labels, about screen, ...): layout is cached per text/color.
+bool renderText(std::string_view text, int x, int y, TTF_Font* font, SDL_Color color, SDL_Renderer* renderer);
+// Strings that change often (counters, timers): laid out every call, never cached.
+bool renderDynamicText(std::string_view text, int x, int y, TTF_Font* font, SDL_Color color, SDL_Renderer* renderer);
+
+#endif // TEXT_H
@@ -0,0 +1,56 @@
+#include "thread_pool.h"
+
+#include <algorithm>
+
+ThreadPool::ThreadPool(int threadCount) {
+    threadCount = std::max(1, threadCount);
+    mWorkers.reserve(threadCount);
+    for (int i = 0; i < threadCount; ++i) mWorkers.emplace_back(&ThreadPool::workerLoop, this);
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mStopping = true;
+    }
+    mJobAvailable.notify_all();
+    for (auto& worker : mWorkers) worker.join();
+}
+
+void ThreadPool::enqueue(std::function<void()> job) {
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mJobs.push(std::move(job));
+    }
+    mJobAvailable.notify_one();
+}
+
+void ThreadPool::waitIdle() {
+    std::unique_lock<std::mutex> lock(mMutex);
+    mIdle.wait(lock, [this] { return mJobs.empty() && mRunning == 0; });
+}
+
+int ThreadPool::defaultThreadCount() {
+    int hardware = (int)std::thread::hardware_concurrency();
+    return std::max(1, hardware - 1);
+}
+
+void ThreadPool::workerLoop() {
+    for (;;) {
+        std::function<void()> job;
+        {
+            std::unique_lock<std::mutex> lock(mMutex);
+            mJobAvailable.wait(lock, [this] { return mStopping || !mJobs.empty(); });
+            if (mJobs.empty()) return; // Stopping and drained
+            job = std::move(mJobs.front());
+            mJobs.pop();
+            ++mRunning;
+        }
+        job();
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            --mRunning;
+            if (mJobs.empty() && mRunning == 0) mIdle.notify_all();
+        }
+    }
+}
@@ -0,0 +1,38 @@
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <vector>
+
+// Fixed-size worker pool. Jobs run in FIFO order; the destructor finishes the
+// queued jobs and joins every worker.
+class ThreadPool {
+public:
+    explicit ThreadPool(int threadCount);
+    ~ThreadPool();
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    void enqueue(std::function<void()> job);
+    void waitIdle(); // Blocks until the queue is empty and no job is running
+    int size() const { return (int)mWorkers.size(); }
+
+    static int defaultThreadCount(); // Hardware threads minus the main thread, at least 1
+
+private:
+    void workerLoop();
+
+    std::vector<std::thread> mWorkers;
+    std::queue<std::function<void()>> mJobs;
+    std::mutex mMutex;
+    std::condition_variable mJobAvailable;
+    std::condition_variable mIdle;
+    int mRunning = 0;
+    bool mStopping = false;
+};
+
+#endif // THREAD_POOL_H
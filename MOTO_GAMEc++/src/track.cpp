@@ -0,0 +1,269 @@
+#include <algorithm>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "config.h"
+#include "track.h"
+
+// --- Parsing ---
+namespace {
+
+bool parseLane(const std::string& word, TrackElementKind kind, std::uint8_t& lane) {
+    if (word == "top") lane = LANE_TOP;
+    else if (word == "bottom") lane = LANE_BOTTOM;
+    else if (word == "middle" && kind == TrackElementKind::COIN) lane = LANE_MIDDLE;
+    else return false;
+    return true;
+}
+
+} // namespace
+
+bool parseTrack(const std::string& text, const std::string& sourceName, Track& track) {
+    track = Track();
+    std::istringstream in(text);
+    std::string line;
+    int lineNumber = 0;
+    bool ok = true;
+    TrackSegment* segment = nullptr;
+    auto fail = [&](const std::string& message) {
+        std::cerr << "ERROR: " << sourceName << ":" << lineNumber << ": " << message << std::endl;
+        ok = false;
+    };
+
+    while (std::getline(in, line)) {
+        lineNumber++;
+        line = line.substr(0, line.find('#'));
+        std::istringstream words(line);
+        std::string directive;
+        if (!(words >> directive)) continue;
+
+        if (directive == "track") { std::getline(words >> std::ws, track.name); }
+        else if (directive == "order") {
+            std::string order;
+            words >> order;
+            if (order == "random" || order == "sequence") track.sequential = order == "sequence";
+            else fail("order must be 'random' or 'sequence'");
+        } else if (directive == "segment") {
+            if (segment) fail("segment '" + segment->name + "' is missing 'end'");
+            TrackSegment next;
+            if (!(words >> next.name >> next.length) || next.length <= 0.0f) { fail("expected: segment <name> <length> [weight]"); segment = nullptr; continue; }
+            if (!(words >> next.weight)) next.weight = 1;
+            track.segments.push_back(next);
+            segment = &track.segments.back();
+        } else if (directive == "barrier" || directive == "coin") {
+            if (!segment) { fail(directive + " outside of a segment"); continue; }
+            TrackElement element = {};
+            element.kind = directive == "barrier" ? TrackElementKind::BARRIER : TrackElementKind::COIN;
+            std::string laneWord, typeWord;
+            if (!(words >> element.offset >> laneWord) || !parseLane(laneWord, element.kind, element.lane)) {
+                fail(directive == "barrier" ? "expected: barrier <offset> top|bottom [type]" : "expected: coin <offset> top|middle|bottom");
+                continue;
+            }
+            element.type = 0;
+            if (element.kind == TrackElementKind::BARRIER && (words >> typeWord)) {
+                if (typeWord == "?") element.type = TRACK_RANDOM_TYPE;
+                else if (typeWord == "0" || typeWord == "1" || typeWord == "2") element.type = (std::uint8_t)(typeWord[0] - '0');
+                else fail("barrier type must be 0, 1, 2 or ?");
+            }
+            if (element.offset < 0.0f || element.offset >= segment->length) fail("offset outside of segment '" + segment->name + "'");
+            segment->elements.push_back(element);
+        } else if (directive == "end") {
+            if (!segment) { fail("'end' without a segment"); continue; }
+            std::stable_sort(segment->elements.begin(), segment->elements.end(), [](const TrackElement& a, const TrackElement& b) { return a.offset < b.offset; });
+            if ((int)segment->elements.size() > TRACK_MAX_SEGMENT_ELEMENTS) fail("segment '" + segment->name + "' has more than " + std::to_string(TRACK_MAX_SEGMENT_ELEMENTS) + " elements");
+            segment = nullptr;
+        } else {
+            fail("unknown directive '" + directive + "'");
+        }
+    }
+    if (segment) fail("segment '" + segment->name + "' is missing 'end'");
+    if (track.segments.empty()) fail("no segments");
+    return ok;
+}
+
+float trackLaneY(int lane, int height) {
+    if (lane == LANE_TOP) return (float)ROAD_Y;
+    if (lane == LANE_BOTTOM) return (float)(ROAD_Y + ROAD_HEIGHT - height);
+    return (float)(ROAD_Y + (ROAD_HEIGHT - height) / 2);
+}
+
+// --- Validation ---
+// Steps the road at the fixed tick rate and marks, per tick, which player heights
+// collide with a barrier. Whole sprite boxes are used: collision masks and the inset
+// fallback boxes only ever hit inside them. The player box is widened to its whole
+// horizontal range, so the result holds wherever the player sits. A backward pass
+// then finds the heights from which some sequence of up/down moves survives to the end.
+namespace {
+
+const int PLAYER_ROWS = PLAYER_BOUNDS_BOTTOM - PLAYER_BOUNDS_TOP + 1;
+const float VALIDATION_MARGIN = BARRIER_SPEED / SIM_TICK_RATE + 1.0f; // Pixels: collisions are swept over a tick, plus rounding
+const float PLAYER_LEFT = PLAYER_START_X - PLAYER_HORIZ_MOVE_RANGE;
+const float PLAYER_RIGHT = PLAYER_START_X + PLAYER_HORIZ_MOVE_RANGE + PLAYER_SQUARE_SIZE;
+
+struct PlacedBarrier {
+    float position; // Scroll distance at which it spawns
+    float y;
+};
+
+void addBarriers(const TrackSegment& segment, float start, std::vector<PlacedBarrier>& out) {
+    for (const TrackElement& e : segment.elements) {
+        if (e.kind == TrackElementKind::BARRIER) out.push_back({ start + e.offset, trackLaneY(e.lane, BARRIER_HEIGHT) });
+    }
+}
+
+// Distance of the tick that no height survives, or -1 when every entry height passes
+float findBlockedDistance(const std::vector<PlacedBarrier>& barriers, float totalLength) {
+    const float step = BARRIER_SPEED / SIM_TICK_RATE;
+    const int reach = std::max(1, (int)(PLAYER_VERT_SPEED / SIM_TICK_RATE)); // Whole rows per tick, rounded down
+    const int ticks = (int)((totalLength + SCREEN_WIDTH) / step) + 1;
+
+    std::vector<std::vector<char>> free(ticks, std::vector<char>(PLAYER_ROWS, 1));
+    for (int t = 0; t < ticks; ++t) {
+        float distance = t * step;
+        for (const PlacedBarrier& b : barriers) {
+            if (distance < b.position) continue;
+            float x = SCREEN_WIDTH - (distance - b.position);
+            if (x >= PLAYER_RIGHT + VALIDATION_MARGIN || x + BARRIER_WIDTH <= PLAYER_LEFT - VALIDATION_MARGIN) continue;
+            for (int row = 0; row < PLAYER_ROWS; ++row) {
+                float y = (float)(PLAYER_BOUNDS_TOP + row);
+                if (y < b.y + BARRIER_HEIGHT + VALIDATION_MARGIN && y + PLAYER_SQUARE_SIZE > b.y - VALIDATION_MARGIN) free[t][row] = 0;
+            }
+        }
+    }
+
+    std::vector<char> good = free[ticks - 1], previous(PLAYER_ROWS);
+    float blockedAt = -1.0f;
+    for (int t = ticks - 2; t >= 0; --t) {
+        previous.swap(good);
+        bool any = false;
+        for (int row = 0; row < PLAYER_ROWS; ++row) {
+            char reachable = 0;
+            for (int r = std::max(0, row - reach); r <= std::min(PLAYER_ROWS - 1, row + reach) && !reachable; ++r) reachable = previous[r];
+            good[row] = free[t][row] && reachable;
+            any = any || good[row];
+        }
+        if (!any && blockedAt < 0.0f) blockedAt = t * step; // The latest such tick is where the wall is
+    }
+    if (blockedAt < 0.0f && std::count(good.begin(), good.end(), 1) != PLAYER_ROWS) blockedAt = 0.0f;
+    return blockedAt;
+}
+
+bool overlapsBarrier(const TrackSegment& segment, const TrackElement& coin) {
+    float coinY = trackLaneY(coin.lane, COIN_HEIGHT);
+    for (const TrackElement& e : segment.elements) {
+        if (e.kind != TrackElementKind::BARRIER) continue;
+        float barrierY = trackLaneY(e.lane, BARRIER_HEIGHT);
+        if (coin.offset < e.offset + BARRIER_WIDTH && coin.offset + COIN_WIDTH > e.offset && coinY < barrierY + BARRIER_HEIGHT && coinY + COIN_HEIGHT > barrierY) return true;
+    }
+    return false;
+}
+
+} // namespace
+
+bool validateTrack(const Track& track, std::ostream& report) {
+    bool ok = true;
+    for (const TrackSegment& segment : track.segments) {
+        if (segment.length < TRACK_MIN_SEGMENT_LENGTH) { report << "  FAIL " << segment.name << ": shorter than " << TRACK_MIN_SEGMENT_LENGTH << " px\n"; ok = false; }
+        for (const TrackElement& e : segment.elements) {
+            if (e.kind == TrackElementKind::COIN && overlapsBarrier(segment, e)) { report << "  FAIL " << segment.name << ": coin at " << e.offset << " overlaps a barrier\n"; ok = false; }
+        }
+    }
+    // Pairs cover every junction; segments are long enough that only neighbours interact
+    for (const TrackSegment& first : track.segments) {
+        for (const TrackSegment& second : track.segments) {
+            std::vector<PlacedBarrier> barriers;
+            addBarriers(first, 0.0f, barriers);
+            addBarriers(second, first.length, barriers);
+            float blockedAt = findBlockedDistance(barriers, first.length + second.length);
+            if (blockedAt >= 0.0f) {
+                report << "  FAIL " << first.name << " -> " << second.name << ": not passable from every position (blocked around distance " << (int)blockedAt << ")\n";
+                ok = false;
+            }
+        }
+    }
+    return ok;
+}
+
+// --- Streamer ---
+namespace {
+
+void fillFromTemplate(SegmentSlot& slot, const TrackSegment& segment) {
+    slot.length = segment.length;
+    slot.count = std::min((int)segment.elements.size(), TRACK_MAX_SEGMENT_ELEMENTS);
+    std::copy_n(segment.elements.begin(), slot.count, slot.elements);
+}
+
+// Classic spawning: a barrier every barrierSpacing and a coin every coinSpacing of travel, random lanes
+void fillGenerated(TrackStreamer& streamer, SegmentSlot& slot, std::mt19937& rng) {
+    slot.length = (TRACK_MAX_SEGMENT_ELEMENTS / 2 - 1) * std::min(streamer.barrierSpacing, streamer.coinSpacing);
+    float end = slot.start + slot.length;
+    std::uniform_int_distribution<> laneDist(0, 1);
+    slot.count = 0;
+    while (streamer.nextBarrierAt < end || streamer.nextCoinAt < end) {
+        bool barrier = streamer.nextBarrierAt <= streamer.nextCoinAt;
+        float& at = barrier ? streamer.nextBarrierAt : streamer.nextCoinAt;
+        TrackElement& e = slot.elements[slot.count++];
+        e.offset = at - slot.start;
+        e.kind = barrier ? TrackElementKind::BARRIER : TrackElementKind::COIN;
+        e.lane = laneDist(rng) == 0 ? LANE_TOP : LANE_BOTTOM;
+        e.type = TRACK_RANDOM_TYPE;
+        at += barrier ? streamer.barrierSpacing : streamer.coinSpacing;
+    }
+}
+
+void queueSegment(TrackStreamer& streamer, SegmentSlot& slot, std::mt19937& rng) {
+    slot.start = streamer.frontier;
+    slot.next = 0;
+    const Track* track = streamer.track;
+    if (!track) {
+        fillGenerated(streamer, slot, rng);
+    } else if (track->sequential) {
+        fillFromTemplate(slot, track->segments[streamer.sequenceIndex]);
+        streamer.sequenceIndex = (streamer.sequenceIndex + 1) % (int)track->segments.size();
+    } else {
+        int totalWeight = 0;
+        for (const TrackSegment& s : track->segments) totalWeight += std::max(0, s.weight);
+        int pick = std::uniform_int_distribution<>(0, std::max(0, totalWeight - 1))(rng);
+        size_t index = 0;
+        while (index + 1 < track->segments.size() && pick >= std::max(0, track->segments[index].weight)) { pick -= std::max(0, track->segments[index].weight); index++; }
+        fillFromTemplate(slot, track->segments[index]);
+    }
+    streamer.frontier += slot.length;
+}
+
+} // namespace
+
+void resetTrackStreamer(TrackStreamer& streamer, const Track* track, float barrierSpacing, float coinSpacing) {
+    streamer.track = (track && !track->segments.empty()) ? track : nullptr;
+    streamer.head = 0;
+    streamer.distance = 0.0f;
+    streamer.frontier = 0.0f;
+    streamer.sequenceIndex = 0;
+    streamer.barrierSpacing = std::max(barrierSpacing, 0.01f);
+    streamer.coinSpacing = std::max(coinSpacing, 0.01f);
+    streamer.nextBarrierAt = streamer.barrierSpacing; // The classic timers fired after one full interval
+    streamer.nextCoinAt = streamer.coinSpacing;
+    for (SegmentSlot& slot : streamer.ring) slot = SegmentSlot{ 0.0f, 0.0f, 0, 0, {} }; // Empty: the first tick fills the ring
+}
+
+void streamTrack(TrackStreamer& streamer, float advance, EntityStore& barriers, EntityStore& coins, std::mt19937& rng) {
+    streamer.distance += advance;
+    for (;;) {
+        SegmentSlot& slot = streamer.ring[streamer.head];
+        while (slot.next < slot.count && slot.start + slot.elements[slot.next].offset <= streamer.distance) {
+            const TrackElement& e = slot.elements[slot.next++];
+            float x = SCREEN_WIDTH - (streamer.distance - (slot.start + e.offset)); // Includes the part of this tick's travel already past
+            if (e.kind == TrackElementKind::BARRIER) {
+                int type = e.type == TRACK_RANDOM_TYPE ? std::uniform_int_distribution<>(0, 2)(rng) : e.type;
+                spawnEntity(barriers, x, trackLaneY(e.lane, BARRIER_HEIGHT), type);
+            } else {
+                spawnEntity(coins, x, trackLaneY(e.lane, COIN_HEIGHT), 0);
+            }
+        }
+        if (slot.next < slot.count || streamer.distance < slot.start + slot.length) break;
+        queueSegment(streamer, slot, rng); // Spent: recycle as the newest segment
+        streamer.head = (streamer.head + 1) % TRACK_RING_SEGMENTS;
+    }
+}
@@ -0,0 +1,92 @@
+#ifndef TRACK_H
+#define TRACK_H
+
+#include <cstdint>
+#include <iosfwd>
+#include <random>
+#include <string>
+#include <vector>
+#include "entities.h"
+
+// --- Track Segments ---
+// A track is a set of segment templates, each a strip of road with barriers and
+// coins at fixed offsets (pixels of scroll distance from the segment start). Text
+// format, one directive per line, '#' starts a comment:
+//   track <name>
+//   order random|sequence          random: weighted picks, sequence: loop in file order
+//   segment <name> <length> [weight]
+//   barrier <offset> top|bottom [type 0-2 | ?]
+//   coin <offset> top|middle|bottom
+//   end
+// tools/track_validator.cpp checks offline that every segment, and every pair of
+// segments back to back, can be passed from any player position.
+
+enum class TrackElementKind : std::uint8_t { BARRIER, COIN };
+
+enum TrackLane : std::uint8_t {
+    LANE_TOP,
+    LANE_MIDDLE,
+    LANE_BOTTOM
+};
+
+const std::uint8_t TRACK_RANDOM_TYPE = 0xFF; // Barrier texture picked at spawn time
+
+struct TrackElement {
+    float offset;
+    TrackElementKind kind;
+    std::uint8_t lane;
+    std::uint8_t type;
+};
+
+struct TrackSegment {
+    std::string name;
+    float length = 0.0f;
+    int weight = 1;
+    std::vector<TrackElement> elements; // Sorted by offset
+};
+
+struct Track {
+    std::string name;
+    bool sequential = false;
+    std::vector<TrackSegment> segments;
+};
+
+bool parseTrack(const std::string& text, const std::string& sourceName, Track& track);
+bool validateTrack(const Track& track, std::ostream& report); // true when every segment and junction is passable
+float trackLaneY(int lane, int height); // Screen y of an element of the given height
+
+// --- Streamer ---
+// A fixed ring of upcoming segment instances ahead of the camera. As the road scrolls,
+// elements whose start comes into view are spawned at the right screen edge; spent
+// segments are recycled into new ones at the back. Memory and per-tick cost do not
+// grow with race length. Without a track (or in stress mode) segments are generated
+// with the classic fixed spacing (WorldRules barrierSpacing/coinSpacing of travel).
+const int TRACK_RING_SEGMENTS = 4;
+const int TRACK_MAX_SEGMENT_ELEMENTS = 64;
+
+struct SegmentSlot {
+    float start;  // Scroll distance where the segment begins
+    float length;
+    int count;
+    int next;     // First element not spawned yet
+    TrackElement elements[TRACK_MAX_SEGMENT_ELEMENTS];
+};
+
+struct TrackStreamer {
+    const Track* track = nullptr; // nullptr: generated segments
+    SegmentSlot ring[TRACK_RING_SEGMENTS];
+    int head = 0;
+    float distance = 0.0f;   // Total scroll so far
+    float frontier = 0.0f;   // End of the newest queued segment
+    int sequenceIndex = 0;
+    float barrierSpacing = 0.0f; // Generated segments only
+    float coinSpacing = 0.0f;
+    float nextBarrierAt = 0.0f;  // Spacing carries across segment borders
+    float nextCoinAt = 0.0f;
+};
+
+// Draws nothing from the RNG, so it may run before the run's seed is set
+void resetTrackStreamer(TrackStreamer& streamer, const Track* track, float barrierSpacing, float coinSpacing);
+void streamTrack(TrackStreamer& streamer, float advance, EntityStore& barriers, EntityStore& coins, std::mt19937& rng);
+
+#endif // TRACK_H
@@ -3,6 +3,7 @@
 
 // --- Game States ---
 enum class GameState {
+    LOADING,
     MENU,
     INTRO,
     ABOUT,
@@ -14,18 +15,6 @@ enum class GameState {
     EXIT
 };
 
-// --- Game Object Structs ---
-struct Barrier {
-    float x;
-    float y;
-    bool active;
-    int textureIndex;
-};
-
-struct Coin {
-    float x;
-    float y;
-    bool active;
-};
+// Barriers and coins are stored as structure-of-arrays, see entities.h
 
 #endif // TYPES_H
\ No newline at end of file
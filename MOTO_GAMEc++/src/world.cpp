@@ -0,0 +1,129 @@
+#include <algorithm>
+
+#include "config.h"
+#include "world.h"
+
+// --- World Lifecycle ---
+bool isSessionState(GameState state) {
+    return state == GameState::PLAYING || state == GameState::WIN_DELAY;
+}
+
+void resetWorld(World& world, const WorldRules& rules) {
+    world.rules = rules;
+    world.state = GameState::PLAYING;
+    world.input = 0;
+    world.playerY = PLAYER_BOUNDS_TOP + (PLAYER_BOUNDS_BOTTOM - PLAYER_BOUNDS_TOP) / 2;
+    world.playerX = PLAYER_START_X;
+    world.prevPlayerX = world.playerX;
+    world.prevPlayerY = world.playerY;
+    world.gameTimer = 0.0f;
+    world.winDelayTimer = 0.0f;
+    world.scrollDistance = 0.0f;
+    world.prevScrollDistance = world.scrollDistance;
+    initEntityStore(world.barriers, rules.maxBarriers);
+    initEntityStore(world.coins, rules.maxCoins);
+    resetTrackStreamer(world.track, rules.track, rules.barrierSpacing, rules.coinSpacing);
+    world.coinCounter = 0;
+}
+
+void seedWorld(World& world, std::uint32_t seed) {
+    world.rng.seed(seed);
+}
+
+// Interpolation: remember where everything was before the next tick
+void storeWorldPositions(World& world) {
+    world.prevPlayerX = world.playerX;
+    world.prevPlayerY = world.playerY;
+    world.prevScrollDistance = world.scrollDistance;
+    storeEntityPositions(world.barriers);
+    storeEntityPositions(world.coins);
+}
+
+void copyWorld(World& dst, const World& src) {
+    dst.state = src.state;
+    dst.input = src.input;
+    dst.playerX = src.playerX;
+    dst.playerY = src.playerY;
+    dst.prevPlayerX = src.prevPlayerX;
+    dst.prevPlayerY = src.prevPlayerY;
+    dst.gameTimer = src.gameTimer;
+    dst.winDelayTimer = src.winDelayTimer;
+    dst.scrollDistance = src.scrollDistance;
+    dst.prevScrollDistance = src.prevScrollDistance;
+    copyEntityStore(dst.barriers, src.barriers);
+    copyEntityStore(dst.coins, src.coins);
+    dst.coinCounter = src.coinCounter;
+}
+
+// --- Simulation ---
+// Player kinematics from one tick of move bits
+void stepPlayer(float& x, float& y, std::uint8_t inputBits, float deltaTime) {
+    float deltaY = 0.0f;
+    if (inputBits & INPUT_UP) { deltaY -= PLAYER_VERT_SPEED * deltaTime; }
+    if (inputBits & INPUT_DOWN) { deltaY += PLAYER_VERT_SPEED * deltaTime; }
+    y += deltaY;
+    y = std::max((float)PLAYER_BOUNDS_TOP, std::min(y, (float)PLAYER_BOUNDS_BOTTOM));
+
+    float deltaX = 0.0f;
+    if (inputBits & INPUT_LEFT) { deltaX -= PLAYER_HORIZ_SPEED * deltaTime; }
+    if (inputBits & INPUT_RIGHT) { deltaX += PLAYER_HORIZ_SPEED * deltaTime; }
+    x += deltaX;
+    x = std::max(PLAYER_START_X - PLAYER_HORIZ_MOVE_RANGE, std::min(x, PLAYER_START_X + PLAYER_HORIZ_MOVE_RANGE));
+}
+
+namespace {
+
+// Not wrapped: every parallax layer wraps at its own width
+void scrollBackground(World& world, float deltaTime) {
+    world.scrollDistance += BARRIER_SPEED * deltaTime;
+}
+
+} // namespace
+
+void stepWorld(World& world, float deltaTime) {
+    switch (world.state) {
+        case GameState::PLAYING: {
+            world.gameTimer += deltaTime;
+            if (world.gameTimer >= WIN_TIME) {
+                world.state = GameState::WIN_DELAY;
+                world.winDelayTimer = 0.0f;
+            }
+
+            PlayerSweep sweep = { world.playerX, world.playerY, 0.0f, 0.0f, PLAYER_SQUARE_SIZE };
+            stepPlayer(world.playerX, world.playerY, world.input, deltaTime);
+            sweep.toX = world.playerX;
+            sweep.toY = world.playerY;
+
+            streamTrack(world.track, BARRIER_SPEED * deltaTime, world.barriers, world.coins, world.rng);
+
+            // Swept tests: a long tick cannot carry a barrier through the player unnoticed.
+            // With masks the sprite boxes only pick the candidates for the pixel test.
+            const float entityDeltaX = -BARRIER_SPEED * deltaTime;
+            float impact, crashTime = 1.0f;
+            moveEntities(world.barriers, entityDeltaX);
+            cullEntitiesLeftOf(world.barriers, 0.0f, BARRIER_WIDTH);
+            const bool masks = world.rules.playerMask && world.rules.barrierMasks;
+            int barrierHits = sweepEntities(world.barriers, entityDeltaX, sweep, BARRIER_WIDTH, BARRIER_HEIGHT, masks ? 0 : BARRIER_HITBOX_INSET, 1.0f, impact);
+            if (barrierHits > 0 && masks) barrierHits = refineSweepHits(world.barriers, entityDeltaX, sweep, *world.rules.playerMask, world.rules.barrierMasks, 1.0f, impact);
+            if (barrierHits > 0 && !world.rules.invulnerable) {
+                world.state = GameState::LOSE;
+                crashTime = impact;
+            }
+
+            moveEntities(world.coins, entityDeltaX);
+            cullEntitiesLeftOf(world.coins, 0.0f, COIN_WIDTH);
+            if (sweepEntities(world.coins, entityDeltaX, sweep, COIN_WIDTH, COIN_HEIGHT, 0, crashTime, impact) > 0) { // Only coins reached before a crash
+                for (int i = world.coins.count - 1; i >= 0; --i) {
+                    if (world.coins.hits[i]) { removeEntity(world.coins, i); world.coinCounter++; }
+                }
+            }
+            scrollBackground(world, deltaTime);
+        } break;
+        case GameState::WIN_DELAY: {
+            world.winDelayTimer += deltaTime;
+            scrollBackground(world, deltaTime);
+            if (world.winDelayTimer >= WIN_DELAY_TIME) world.state = GameState::WIN;
+        } break;
+        default: break;
+    }
+}
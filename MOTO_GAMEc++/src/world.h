@@ -0,0 +1,69 @@
+#ifndef WORLD_H
+#define WORLD_H
+
+#include <cstdint>
+#include <random>
+#include "types.h"
+#include "entities.h"
+#include "track.h"
+
+// --- Gameplay World ---
+// Everything one PLAYING session simulates. stepWorld() is the whole fixed tick for
+// PLAYING and WIN_DELAY: it only touches the World, which carries its own rules and
+// RNG, never globals, audio, replay files or the renderer. It can run on the
+// simulation thread (sim_thread.h), and world.cpp, track.cpp and entities.cpp build
+// without SDL, so tools/batch_sim.cpp runs thousands of Worlds side by side.
+// Transitions show up in world.state.
+
+enum RunInputBits : std::uint8_t {
+    INPUT_UP = 1 << 0,
+    INPUT_DOWN = 1 << 1,
+    INPUT_LEFT = 1 << 2,
+    INPUT_RIGHT = 1 << 3
+};
+
+// Per-session settings; the game fills them from its globals (stress mode, --track)
+struct WorldRules {
+    int maxBarriers = 0;
+    int maxCoins = 0;
+    float barrierSpacing = 0.0f;   // Pixels of travel between generated barriers
+    float coinSpacing = 0.0f;
+    const Track* track = nullptr;  // nullptr: generated segments; must outlive the World
+    bool invulnerable = false;     // Barrier hits do not end the run (stress mode)
+    // Pixel-accurate barrier hits (collision_mask.h); both must outlive the World.
+    // Without them barriers collide as boxes inset by BARRIER_HITBOX_INSET.
+    const CollisionMask* playerMask = nullptr;
+    const CollisionMask* barrierMasks = nullptr; // Array indexed by barrier type
+};
+
+struct World {
+    GameState state = GameState::PLAYING; // PLAYING, WIN_DELAY, then LOSE or WIN
+    std::uint8_t input = 0;               // RunInputBits held this tick
+    float playerX = 0.0f;
+    float playerY = 0.0f;
+    float prevPlayerX = 0.0f;             // Previous-tick values for render interpolation
+    float prevPlayerY = 0.0f;
+    float gameTimer = 0.0f;
+    float winDelayTimer = 0.0f;
+    float scrollDistance = 0.0f;          // Pixels the road has moved; drives the parallax layers
+    float prevScrollDistance = 0.0f;
+    EntityStore barriers;
+    EntityStore coins;
+    TrackStreamer track;                  // Spawns barriers and coins as the road scrolls
+    int coinCounter = 0;
+    WorldRules rules;
+    std::mt19937 rng;                     // Spawning only; seeded per run (seedWorld)
+};
+
+bool isSessionState(GameState state); // PLAYING or WIN_DELAY
+void resetWorld(World& world, const WorldRules& rules); // Sizes the entity stores, restarts the track; leaves the RNG
+void seedWorld(World& world, std::uint32_t seed);
+void storeWorldPositions(World& world);
+void stepWorld(World& world, float deltaTime);
+void stepPlayer(float& x, float& y, std::uint8_t inputBits, float deltaTime); // Also drives the replay ghost
+
+// Copies the live entity range only; dst keeps its allocations (no heap traffic per tick).
+// The track streamer, rules and RNG are simulation state and are not copied.
+void copyWorld(World& dst, const World& src);
+
+#endif // WORLD_H
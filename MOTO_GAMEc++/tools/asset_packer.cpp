@@ -0,0 +1,174 @@
+// Asset Packer
+// Converts the assets/ tree into bin/assets.pak (layout in src/archive_format.h):
+//   - images are decoded once and stored as ARGB8888 pixel blobs
+//   - short WAVs are converted to raw PCM at the mixer format
+//   - long sounds (streamed by the game), fonts and anything else are stored as-is
+//
+// Build (Windows): the "Build Asset Packer" task in .vscode/tasks.json, then "Pack Assets".
+// Build (Linux):   g++ -O2 -std=c++17 tools/asset_packer.cpp -Isrc $(sdl2-config --cflags --libs) -lSDL2_image -o bin/asset_packer
+// Usage:           asset_packer <assets dir> <output .pak>
+
+#include <SDL.h>
+#include <SDL_image.h>
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "archive_format.h"
+
+namespace fs = std::filesystem;
+
+// --- Packer Config ---
+const Uint32 PIXEL_FORMAT = SDL_PIXELFORMAT_ARGB8888; // Native texture format of the D3D/GL renderers
+const uintmax_t SHORT_SOUND_MAX_BYTES = 256 * 1024;    // Larger sounds are streamed, keep them encoded
+
+struct PackedEntry {
+    ArchiveEntry entry;
+    std::vector<Uint8> data;
+};
+
+std::string lowerExtension(const fs::path& path) {
+    return normalizeArchiveName(path.extension().string());
+}
+
+bool readFile(const fs::path& path, std::vector<Uint8>& out) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file) return false;
+    out.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    return true;
+}
+
+bool packImage(const fs::path& path, PackedEntry& packed) {
+    SDL_Surface* loaded = IMG_Load(path.string().c_str());
+    if (!loaded) { std::cerr << "ERROR: Unable to decode " << path.string() << "! SDL_image Error: " << IMG_GetError() << std::endl; return false; }
+    SDL_Surface* converted = SDL_ConvertSurfaceFormat(loaded, PIXEL_FORMAT, 0);
+    SDL_FreeSurface(loaded);
+    if (!converted) { std::cerr << "ERROR: Unable to convert " << path.string() << "! SDL Error: " << SDL_GetError() << std::endl; return false; }
+
+    int rowBytes = converted->w * 4;
+    packed.entry.kind = (Uint32)ArchiveEntryKind::PIXELS;
+    packed.entry.format = PIXEL_FORMAT;
+    packed.entry.width = (Uint32)converted->w;
+    packed.entry.height = (Uint32)converted->h;
+    packed.entry.pitch = (Uint32)rowBytes; // Tightly packed, whatever the surface pitch was
+    packed.data.resize((size_t)rowBytes * converted->h);
+    for (int y = 0; y < converted->h; ++y) {
+        std::memcpy(packed.data.data() + (size_t)y * rowBytes, (const Uint8*)converted->pixels + (size_t)y * converted->pitch, rowBytes);
+    }
+    SDL_FreeSurface(converted);
+    return true;
+}
+
+bool packSound(const fs::path& path, PackedEntry& packed) {
+    SDL_AudioSpec spec;
+    Uint8* samples = nullptr;
+    Uint32 length = 0;
+    if (!SDL_LoadWAV(path.string().c_str(), &spec, &samples, &length)) { std::cerr << "ERROR: Unable to decode " << path.string() << "! SDL Error: " << SDL_GetError() << std::endl; return false; }
+
+    SDL_AudioCVT cvt;
+    if (SDL_BuildAudioCVT(&cvt, spec.format, spec.channels, spec.freq, AUDIO_SAMPLE_FORMAT, AUDIO_CHANNELS, AUDIO_FREQUENCY) < 0) {
+        std::cerr << "ERROR: Unsupported audio format in " << path.string() << "! SDL Error: " << SDL_GetError() << std::endl;
+        SDL_FreeWAV(samples);
+        return false;
+    }
+    std::vector<Uint8> buffer((size_t)length * (cvt.len_mult > 0 ? cvt.len_mult : 1));
+    std::memcpy(buffer.data(), samples, length);
+    SDL_FreeWAV(samples);
+    cvt.buf = buffer.data();
+    cvt.len = (int)length;
+    if (cvt.needed && SDL_ConvertAudio(&cvt) != 0) { std::cerr << "ERROR: Unable to convert " << path.string() << "! SDL Error: " << SDL_GetError() << std::endl; return false; }
+    buffer.resize(cvt.needed ? (size_t)cvt.len_cvt : (size_t)length);
+
+    packed.entry.kind = (Uint32)ArchiveEntryKind::PCM;
+    packed.entry.format = AUDIO_SAMPLE_FORMAT;
+    packed.entry.width = AUDIO_FREQUENCY;
+    packed.entry.height = AUDIO_CHANNELS;
+    packed.data = std::move(buffer);
+    return true;
+}
+
+bool packBlob(const fs::path& path, PackedEntry& packed) {
+    packed.entry.kind = (Uint32)ArchiveEntryKind::BLOB;
+    if (!readFile(path, packed.data)) { std::cerr << "ERROR: Unable to read " << path.string() << "!" << std::endl; return false; }
+    return true;
+}
+
+bool packFile(const fs::path& root, const fs::path& path, PackedEntry& packed) {
+    std::memset(&packed.entry, 0, sizeof(packed.entry));
+    std::string name = normalizeArchiveName(fs::relative(path, root).generic_string());
+    if (name.size() >= ARCHIVE_NAME_SIZE) { std::cerr << "ERROR: Asset path too long for the archive index: " << name << std::endl; return false; }
+    std::memcpy(packed.entry.name, name.c_str(), name.size());
+
+    std::string ext = lowerExtension(path);
+    if (ext == ".png" || ext == ".jpg" || ext == ".jpeg" || ext == ".bmp") return packImage(path, packed);
+    if (ext == ".wav" && fs::file_size(path) <= SHORT_SOUND_MAX_BYTES) return packSound(path, packed);
+    return packBlob(path, packed);
+}
+
+void writePadding(std::ofstream& out, Uint64& offset) {
+    static const char zeros[ARCHIVE_ALIGNMENT] = {};
+    Uint64 padding = (ARCHIVE_ALIGNMENT - offset % ARCHIVE_ALIGNMENT) % ARCHIVE_ALIGNMENT;
+    out.write(zeros, (std::streamsize)padding);
+    offset += padding;
+}
+
+int main(int argc, char* argv[]) {
+    if (argc != 3) { std::cerr << "Usage: " << argv[0] << " <assets dir> <output .pak>" << std::endl; return 1; }
+    fs::path root = argv[1];
+    if (!fs::is_directory(root)) { std::cerr << "ERROR: " << root.string() << " is not a directory!" << std::endl; return 1; }
+    if (SDL_Init(0) < 0) { std::cerr << "ERROR: SDL could not initialize! SDL_Error: " << SDL_GetError() << std::endl; return 1; }
+    IMG_Init(IMG_INIT_PNG | IMG_INIT_JPG);
+
+    std::vector<fs::path> files;
+    for (const auto& item : fs::recursive_directory_iterator(root)) {
+        if (item.is_regular_file()) files.push_back(item.path());
+    }
+    std::sort(files.begin(), files.end()); // Stable archive layout between runs
+
+    std::ofstream out(argv[2], std::ios::binary | std::ios::trunc);
+    if (!out) { std::cerr << "ERROR: Unable to create " << argv[2] << "!" << std::endl; IMG_Quit(); SDL_Quit(); return 1; }
+
+    ArchiveHeader header = {};
+    std::memcpy(header.magic, ARCHIVE_MAGIC, sizeof(header.magic));
+    header.version = ARCHIVE_VERSION;
+    out.write((const char*)&header, sizeof(header));
+    Uint64 offset = sizeof(header);
+
+    std::vector<ArchiveEntry> index;
+    uintmax_t sourceBytes = 0;
+    bool ok = true;
+    for (const auto& path : files) {
+        PackedEntry packed;
+        if (!packFile(root, path, packed)) { ok = false; continue; }
+        writePadding(out, offset);
+        packed.entry.offset = offset;
+        packed.entry.size = packed.data.size();
+        out.write((const char*)packed.data.data(), (std::streamsize)packed.data.size());
+        offset += packed.data.size();
+        sourceBytes += fs::file_size(path);
+        index.push_back(packed.entry);
+
+        static const char* const KIND_NAMES[] = { "blob", "pixels", "pcm" };
+        std::printf("  %-48s %-6s %10llu bytes\n", packed.entry.name, KIND_NAMES[packed.entry.kind], (unsigned long long)packed.entry.size);
+    }
+
+    writePadding(out, offset);
+    header.entryCount = (Uint32)index.size();
+    header.indexOffset = offset;
+    out.write((const char*)index.data(), (std::streamsize)(index.size() * sizeof(ArchiveEntry)));
+    out.seekp(0);
+    out.write((const char*)&header, sizeof(header));
+    out.close();
+
+    std::printf("Packed %u assets: %.1f MB of source files -> %.1f MB archive.\n", header.entryCount,
+                sourceBytes / (1024.0 * 1024.0), (offset + index.size() * sizeof(ArchiveEntry)) / (1024.0 * 1024.0));
+    IMG_Quit();
+    SDL_Quit();
+    if (!ok || !out) { std::cerr << "ERROR: Archive is incomplete, see errors above." << std::endl; return 1; }
+    return 0;
+}
@@ -0,0 +1,341 @@
+// Batch Simulator
+// Runs many independent PLAYING sessions in parallel, headless, with the game's own
+// rules (world.cpp, track.cpp, entities.cpp; no SDL, no window) and a scripted input
+// policy, then reports simulation throughput and win/lose statistics. Use it to tune
+// config.h (speeds, spawn intervals, WIN_TIME, hitbox insets) or a track file: edit,
+// rebuild, and compare the win rate and the death-time histogram across runs.
+// Barriers collide pixel-exact through the game's sprite masks, rebuilt from the
+// alpha planes tools/mask_builder.cpp writes (--masks, default bin/collision.masks).
+// Without that file they fall back to inset boxes and every run warns about it.
+// --compare-collision plays one seed (--seed) with those masks and with the inset
+// fallback boxes, on the same inputs, and checks the runs differ only in the hit
+// that ends one of them.
+// Session i uses seed (--seed + i), so a batch is reproducible on the same build.
+//
+// Policies:
+//   idle    never moves
+//   random  holds up, down or nothing for a random 0.05-0.5 s, again and again
+//   dodge   looks a short distance ahead, steers to the nearest free height, and
+//           otherwise drifts toward the next coin (a reasonable but imperfect player)
+//
+// Build (Windows): the "Build Batch Simulator" task in .vscode/tasks.json.
+// Build (Linux):   g++ -O2 -std=c++17 -pthread tools/batch_sim.cpp src/world.cpp src/track.cpp src/entities.cpp src/collision_mask.cpp src/thread_pool.cpp -Isrc -o bin/batch_sim
+// Usage:           batch_sim [--sessions N] [--threads N] [--policy idle|random|dodge]
+//                            [--seed S] [--tick-rate N] [--track <file>|none]
+//                            [--masks <file>|none] [--character male|female] [--compare-collision]
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "collision_mask.h"
+#include "config.h"
+#include "thread_pool.h"
+#include "track.h"
+#include "world.h"
+
+namespace {
+
+enum class Policy { IDLE, RANDOM, DODGE };
+
+struct PolicyState {
+    std::mt19937 rng;
+    std::uint8_t bits = 0;
+    int holdTicks = 0;
+};
+
+struct SessionResult {
+    bool won = false;
+    int ticks = 0;
+    int coins = 0;
+};
+
+const int DEATH_BUCKETS = 8; // Over WIN_TIME
+const float DODGE_LOOKAHEAD = BARRIER_SPEED * 0.35f; // Pixels ahead of the player's front edge
+const float DODGE_DEADZONE = 2.0f;
+const int BARRIER_TYPES = 3; // Track barrier types 0-2 (track.h)
+const char* const DEFAULT_MASK_FILE = "collision.masks"; // tools/mask_builder.cpp output, next to the binaries
+
+// The game's collision masks for one character
+struct MaskSet {
+    CollisionMask player;
+    CollisionMask barriers[BARRIER_TYPES]; // Indexed by barrier type, as WorldRules::barrierMasks
+};
+
+bool overlapsBarrier(const World& world, float y, float ahead) {
+    float front = world.playerX + PLAYER_SQUARE_SIZE;
+    for (int i = 0; i < world.barriers.count; ++i) {
+        float bx = world.barriers.x[i], by = world.barriers.y[i];
+        if (bx + BARRIER_WIDTH < world.playerX || bx > front + ahead) continue;
+        if (y < by + BARRIER_HEIGHT && y + PLAYER_SQUARE_SIZE > by) return true;
+    }
+    return false;
+}
+
+std::uint8_t steerTo(float target, float y) {
+    if (target < y - DODGE_DEADZONE) return INPUT_UP;
+    if (target > y + DODGE_DEADZONE) return INPUT_DOWN;
+    return 0;
+}
+
+std::uint8_t dodgeInput(const World& world) {
+    float y = world.playerY;
+    if (overlapsBarrier(world, y, DODGE_LOOKAHEAD)) {
+        const float heights[] = { (float)PLAYER_BOUNDS_TOP, (PLAYER_BOUNDS_TOP + PLAYER_BOUNDS_BOTTOM) * 0.5f, (float)PLAYER_BOUNDS_BOTTOM };
+        float best = y, bestDistance = -1.0f;
+        for (float h : heights) {
+            if (overlapsBarrier(world, h, DODGE_LOOKAHEAD)) continue;
+            float distance = std::abs(h - y);
+            if (bestDistance < 0.0f || distance < bestDistance) { best = h; bestDistance = distance; }
+        }
+        return steerTo(best, y);
+    }
+    int nearest = -1; // Next coin ahead, if it does not lead into a barrier
+    for (int i = 0; i < world.coins.count; ++i) {
+        if (world.coins.x[i] + COIN_WIDTH < world.playerX) continue;
+        if (nearest < 0 || world.coins.x[i] < world.coins.x[nearest]) nearest = i;
+    }
+    if (nearest < 0) return 0;
+    float target = std::clamp(world.coins.y[nearest] + COIN_HEIGHT * 0.5f - PLAYER_SQUARE_SIZE * 0.5f, (float)PLAYER_BOUNDS_TOP, (float)PLAYER_BOUNDS_BOTTOM);
+    if (overlapsBarrier(world, target, DODGE_LOOKAHEAD)) return 0;
+    return steerTo(target, y);
+}
+
+std::uint8_t policyInput(Policy policy, PolicyState& state, const World& world, int tickRate) {
+    switch (policy) {
+        case Policy::RANDOM:
+            if (--state.holdTicks <= 0) {
+                const std::uint8_t choices[] = { 0, INPUT_UP, INPUT_DOWN };
+                state.bits = choices[std::uniform_int_distribution<>(0, 2)(state.rng)];
+                state.holdTicks = std::uniform_int_distribution<>(std::max(1, tickRate / 20), std::max(1, tickRate / 2))(state.rng);
+            }
+            return state.bits;
+        case Policy::DODGE: return dodgeInput(world);
+        default: return 0;
+    }
+}
+
+// One session from reset to LOSE or the win (WIN_DELAY only plays the outro)
+SessionResult runSession(World& world, const WorldRules& rules, std::uint32_t seed, Policy policy, int tickRate) {
+    resetWorld(world, rules);
+    seedWorld(world, seed);
+    PolicyState state;
+    state.rng.seed(seed ^ 0x9E3779B9u); // Independent of the spawn stream
+    float deltaTime = 1.0f / tickRate;
+    SessionResult result;
+    while (world.state == GameState::PLAYING) {
+        world.input = policyInput(policy, state, world, tickRate);
+        stepWorld(world, deltaTime);
+        result.ticks++;
+    }
+    result.won = world.state == GameState::WIN_DELAY;
+    result.coins = world.coinCounter;
+    return result;
+}
+
+const char* policyName(Policy policy) {
+    switch (policy) {
+        case Policy::RANDOM: return "random";
+        case Policy::DODGE: return "dodge";
+        default: return "idle";
+    }
+}
+
+bool loadMaskFile(const std::string& path, const std::string& character, MaskSet& masks) {
+    std::ifstream in(path, std::ios::binary);
+    if (!in) return false;
+    std::vector<AlphaPlane> planes;
+    if (!readAlphaPlanes(in, planes)) { std::cerr << "ERROR: '" << path << "' is not a mask file from mask_builder." << std::endl; return false; }
+    auto build = [&](const std::string& name, int w, int h, CollisionMask& mask) {
+        for (const AlphaPlane& plane : planes) {
+            if (plane.name != name) continue;
+            if (plane.w != w || plane.h != h) {
+                std::cerr << "ERROR: '" << path << "' has " << name << " at " << plane.w << "x" << plane.h << ", not its drawn " << w << "x" << h << "." << std::endl;
+                return false;
+            }
+            buildCollisionMask(mask, plane.alpha.data(), plane.w, plane.h, plane.w, 1, COLLISION_ALPHA_THRESHOLD);
+            return true;
+        }
+        std::cerr << "ERROR: '" << path << "' has no mask for " << name << "." << std::endl;
+        return false;
+    };
+    bool ok = build("player_" + character, PLAYER_SQUARE_SIZE, PLAYER_SQUARE_SIZE, masks.player);
+    for (int t = 0; t < BARRIER_TYPES; ++t) ok = build("barrier_0" + std::to_string(t + 1), BARRIER_WIDTH, BARRIER_HEIGHT, masks.barriers[t]) && ok;
+    return ok;
+}
+
+bool sameRun(const World& a, const World& b) {
+    return a.state == b.state && a.playerX == b.playerX && a.playerY == b.playerY && a.coinCounter == b.coinCounter &&
+           a.barriers.count == b.barriers.count && a.coins.count == b.coins.count;
+}
+
+// One seed with box and with mask collision, fed the same inputs (from the box run
+// while it lasts). Masks only decide which barrier touches end a run, so the two
+// must stay identical until one of them ends. False when they split earlier.
+bool compareCollision(const WorldRules& boxRules, const WorldRules& maskRules, std::uint32_t seed, Policy policy, int tickRate) {
+    World box, masked;
+    resetWorld(box, boxRules);
+    seedWorld(box, seed);
+    resetWorld(masked, maskRules);
+    seedWorld(masked, seed);
+    PolicyState state;
+    state.rng.seed(seed ^ 0x9E3779B9u); // As runSession()
+    float deltaTime = 1.0f / tickRate;
+    int ticks = 0, boxEnd = 0, maskEnd = 0, split = 0;
+    bool splitWhilePlaying = false;
+    while (box.state == GameState::PLAYING || masked.state == GameState::PLAYING) {
+        std::uint8_t input = policyInput(policy, state, box.state == GameState::PLAYING ? box : masked, tickRate);
+        ticks++;
+        if (box.state == GameState::PLAYING) { box.input = input; stepWorld(box, deltaTime); if (box.state != GameState::PLAYING) boxEnd = ticks; }
+        if (masked.state == GameState::PLAYING) { masked.input = input; stepWorld(masked, deltaTime); if (masked.state != GameState::PLAYING) maskEnd = ticks; }
+        if (split == 0 && !sameRun(box, masked)) {
+            split = ticks;
+            splitWhilePlaying = box.state == GameState::PLAYING && masked.state == GameState::PLAYING;
+        }
+    }
+
+    auto outcome = [&](const World& world, int endTick) {
+        std::printf("%s at %.2f s, %d coins\n", world.state == GameState::WIN_DELAY ? "won" : "lost", (float)endTick / tickRate, world.coinCounter);
+    };
+    std::printf("compare-collision: seed %u, policy %s, %d Hz\n", seed, policyName(policy), tickRate);
+    std::printf("  boxes (inset %d): ", BARRIER_HITBOX_INSET);
+    outcome(box, boxEnd);
+    std::printf("  masks:           ");
+    outcome(masked, maskEnd);
+    if (splitWhilePlaying) {
+        std::printf("  FAILED: the runs split at %.2f s while both were still playing\n", (float)split / tickRate);
+        return false;
+    }
+    if (split == 0) std::printf("  identical runs\n");
+    else std::printf("  identical until %.2f s, where the %s run ended\n", (float)split / tickRate, boxEnd == split ? (maskEnd == split ? "both" : "box") : "mask");
+    return true;
+}
+
+bool loadTrackFile(const std::string& path, Track& track) {
+    std::ifstream in(path, std::ios::binary);
+    if (!in) { std::cerr << "WARNING: Track file not found: " << path << ", using generated segments." << std::endl; return false; }
+    std::stringstream text;
+    text << in.rdbuf();
+    if (!parseTrack(text.str(), path, track)) { std::cerr << "WARNING: Track '" << path << "' is invalid, using generated segments." << std::endl; track = Track(); return false; }
+    return true;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    int sessions = 10000;
+    int threads = std::max(1, (int)std::thread::hardware_concurrency());
+    int tickRate = SIM_TICK_RATE;
+    std::uint32_t baseSeed = 1;
+    Policy policy = Policy::DODGE;
+    std::string trackPath = DEFAULT_TRACK_FILE;
+    std::string maskPath = DEFAULT_MASK_FILE;
+    std::string character = "male";
+    bool compare = false;
+    for (int i = 1; i < argc; ++i) {
+        const char* arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (std::strcmp(arg, "--sessions") == 0 && hasValue) sessions = std::max(1, std::atoi(argv[++i]));
+        else if (std::strcmp(arg, "--threads") == 0 && hasValue) threads = std::max(1, std::atoi(argv[++i]));
+        else if (std::strcmp(arg, "--tick-rate") == 0 && hasValue) tickRate = std::max(10, std::atoi(argv[++i]));
+        else if (std::strcmp(arg, "--seed") == 0 && hasValue) baseSeed = (std::uint32_t)std::strtoul(argv[++i], nullptr, 10);
+        else if (std::strcmp(arg, "--track") == 0 && hasValue) trackPath = argv[++i];
+        else if (std::strcmp(arg, "--masks") == 0 && hasValue) maskPath = argv[++i];
+        else if (std::strcmp(arg, "--compare-collision") == 0) compare = true;
+        else if (std::strcmp(arg, "--character") == 0 && hasValue) {
+            character = argv[++i];
+            if (character != "male" && character != "female") { std::cerr << "ERROR: Unknown character '" << character << "' (male, female)." << std::endl; return 1; }
+        }
+        else if (std::strcmp(arg, "--policy") == 0 && hasValue) {
+            std::string name = argv[++i];
+            if (name == "idle") policy = Policy::IDLE;
+            else if (name == "random") policy = Policy::RANDOM;
+            else if (name == "dodge") policy = Policy::DODGE;
+            else { std::cerr << "ERROR: Unknown policy '" << name << "' (idle, random, dodge)." << std::endl; return 1; }
+        } else {
+            std::cerr << "Usage: " << argv[0] << " [--sessions N] [--threads N] [--policy idle|random|dodge] [--seed S] [--tick-rate N] [--track <file>|none]"
+                      << " [--masks <file>|none] [--character male|female] [--compare-collision]" << std::endl;
+            return 1;
+        }
+    }
+
+    Track track;
+    if (trackPath != "none") loadTrackFile(trackPath, track);
+    WorldRules rules;
+    rules.maxBarriers = MAX_BARRIERS;
+    rules.maxCoins = MAX_COINS;
+    rules.barrierSpacing = BARRIER_SPAWN_INTERVAL * BARRIER_SPEED;
+    rules.coinSpacing = COIN_SPAWN_INTERVAL * BARRIER_SPEED;
+    rules.track = track.segments.empty() ? nullptr : &track;
+    MaskSet masks;
+    bool hasMasks = maskPath != "none" && loadMaskFile(maskPath, character, masks);
+    if (!hasMasks && !compare) {
+        std::cerr << "WARNING: " << (maskPath == "none" ? std::string("Collision masks disabled") : "No collision masks from " + maskPath)
+                  << ": barriers collide as boxes inset by " << BARRIER_HITBOX_INSET << " px, so these results do not match the game."
+                  << " Run mask_builder to write the masks." << std::endl;
+    }
+    WorldRules boxRules = rules;
+    if (hasMasks) {
+        rules.playerMask = &masks.player;
+        rules.barrierMasks = masks.barriers;
+    }
+    if (compare) {
+        if (!hasMasks) { std::cerr << "ERROR: --compare-collision needs the collision masks (" << maskPath << "), run mask_builder first." << std::endl; return 1; }
+        return compareCollision(boxRules, rules, baseSeed, policy, tickRate) ? 0 : 1;
+    }
+
+    // Contiguous chunks, a few per thread so uneven session lengths still balance;
+    // each job owns its World and writes only its own slice of the results
+    std::vector<SessionResult> results(sessions);
+    int chunkCount = std::min(sessions, threads * 8);
+    auto start = std::chrono::steady_clock::now();
+    {
+        ThreadPool pool(threads);
+        for (int chunk = 0; chunk < chunkCount; ++chunk) {
+            int begin = (int)((long long)sessions * chunk / chunkCount);
+            int end = (int)((long long)sessions * (chunk + 1) / chunkCount);
+            pool.enqueue([&, begin, end] {
+                World world;
+                for (int i = begin; i < end; ++i) results[i] = runSession(world, rules, baseSeed + (std::uint32_t)i, policy, tickRate);
+            });
+        }
+        pool.waitIdle();
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    long long totalTicks = 0;
+    int wins = 0;
+    long long coinsWon = 0, coinsLost = 0;
+    int deaths[DEATH_BUCKETS] = {};
+    for (const SessionResult& r : results) {
+        totalTicks += r.ticks;
+        if (r.won) { wins++; coinsWon += r.coins; continue; }
+        coinsLost += r.coins;
+        int bucket = (int)((float)r.ticks / tickRate / WIN_TIME * DEATH_BUCKETS);
+        deaths[std::clamp(bucket, 0, DEATH_BUCKETS - 1)]++;
+    }
+    int losses = sessions - wins;
+
+    std::printf("batch_sim: %d sessions, policy %s, %d Hz, %d thread(s), %s, %s\n", sessions, policyName(policy), tickRate, threads,
+        rules.track ? ("track '" + track.name + "'").c_str() : "generated segments", hasMasks ? ("pixel masks (player_" + character + ")").c_str() : "box collision");
+    std::printf("  %lld ticks in %.2f s: %.2f M ticks/s, %.0f sessions/s\n", totalTicks, seconds,
+        seconds > 0.0 ? totalTicks / seconds / 1e6 : 0.0, seconds > 0.0 ? sessions / seconds : 0.0);
+    std::printf("  won %.1f%%, lost %.1f%%; coins per run %.1f (won %.1f, lost %.1f)\n", 100.0 * wins / sessions, 100.0 * losses / sessions,
+        (double)(coinsWon + coinsLost) / sessions, wins ? (double)coinsWon / wins : 0.0, losses ? (double)coinsLost / losses : 0.0);
+    if (losses > 0) {
+        std::printf("  deaths by time:\n");
+        for (int b = 0; b < DEATH_BUCKETS; ++b) {
+            std::printf("    %4.1f-%4.1f s %6.1f%%\n", WIN_TIME * b / DEATH_BUCKETS, WIN_TIME * (b + 1) / DEATH_BUCKETS, 100.0 * deaths[b] / losses);
+        }
+    }
+    return 0;
+}
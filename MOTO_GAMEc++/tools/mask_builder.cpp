@@ -0,0 +1,111 @@
+// Mask Builder
+// Writes bin/collision.masks for the SDL-free tools: the alpha plane of every sprite
+// the game builds a collision mask for (barriers and players, see game.cpp), decoded
+// and pre-scaled to its drawn size exactly as the game's loader does (assets.cpp).
+// tools/batch_sim.cpp turns them back into the masks the game collides with, so its
+// results match the game. Rerun it after changing those images or their sizes in
+// config.h; COLLISION_ALPHA_THRESHOLD is applied when the file is read.
+//
+// Build (Windows): the "Build Mask Builder" task in .vscode/tasks.json, then "Build Collision Masks".
+// Build (Linux):   g++ -O2 -std=c++17 tools/mask_builder.cpp src/collision_mask.cpp -Isrc $(sdl2-config --cflags --libs) -lSDL2_image -o bin/mask_builder
+// Usage:           mask_builder <assets dir> <output file>
+
+#include <SDL.h>
+#include <SDL_image.h>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "collision_mask.h"
+#include "config.h"
+
+// --- Masked Sprites ---
+// Same files and drawn sizes as the queueSpriteLoad(..., true) calls in game.cpp
+struct MaskedSprite {
+    const char* name;
+    const char* path; // Relative to the assets dir
+    int w;
+    int h;
+};
+
+const MaskedSprite MASKED_SPRITES[] = {
+    { "barrier_01", "images/barrier_01.png", BARRIER_WIDTH, BARRIER_HEIGHT },
+    { "barrier_02", "images/barrier_02.png", BARRIER_WIDTH, BARRIER_HEIGHT },
+    { "barrier_03", "images/barrier_03.png", BARRIER_WIDTH, BARRIER_HEIGHT },
+    { "player_male", "images/select/player_male.png", PLAYER_SQUARE_SIZE, PLAYER_SQUARE_SIZE },
+    { "player_female", "images/select/player_female.png", PLAYER_SQUARE_SIZE, PLAYER_SQUARE_SIZE },
+};
+
+// ARGB8888 at the drawn size, as resampleSurface() in assets.cpp produces it: bilinear
+// downscale only, otherwise the decoded size (the game then scales at draw time)
+SDL_Surface* loadDrawnSurface(const std::string& path, int w, int h) {
+    SDL_Surface* loaded = IMG_Load(path.c_str());
+    if (!loaded) { std::cerr << "ERROR: Unable to decode " << path << "! SDL_image Error: " << IMG_GetError() << std::endl; return nullptr; }
+    SDL_Surface* argb = SDL_ConvertSurfaceFormat(loaded, SDL_PIXELFORMAT_ARGB8888, 0);
+    SDL_FreeSurface(loaded);
+    if (!argb) { std::cerr << "ERROR: Unable to convert " << path << "! SDL Error: " << SDL_GetError() << std::endl; return nullptr; }
+    if (w > argb->w || h > argb->h || (w == argb->w && h == argb->h)) return argb;
+    SDL_Surface* scaled = SDL_CreateRGBSurfaceWithFormat(0, w, h, 32, SDL_PIXELFORMAT_ARGB8888);
+    if (!scaled || SDL_SoftStretchLinear(argb, nullptr, scaled, nullptr) != 0) {
+        std::cerr << "WARNING: Unable to scale " << path << ", using its decoded size. SDL Error: " << SDL_GetError() << std::endl;
+        if (scaled) SDL_FreeSurface(scaled);
+        return argb;
+    }
+    SDL_FreeSurface(argb);
+    return scaled;
+}
+
+bool readAlphaPlane(SDL_Surface* surface, AlphaPlane& plane) {
+    if (SDL_LockSurface(surface) != 0) return false;
+    plane.w = surface->w;
+    plane.h = surface->h;
+    plane.alpha.resize((size_t)plane.w * plane.h);
+    // Alpha is the high byte of each 32-bit pixel
+    const Uint8* pixels = static_cast<const Uint8*>(surface->pixels) + (SDL_BYTEORDER == SDL_LIL_ENDIAN ? 3 : 0);
+    for (int y = 0; y < plane.h; ++y) {
+        const Uint8* src = pixels + (size_t)y * surface->pitch;
+        for (int x = 0; x < plane.w; ++x) plane.alpha[(size_t)y * plane.w + x] = src[(size_t)x * 4];
+    }
+    SDL_UnlockSurface(surface);
+    return true;
+}
+
+int main(int argc, char* argv[]) {
+    if (argc != 3) { std::cerr << "Usage: " << argv[0] << " <assets dir> <output file>" << std::endl; return 1; }
+    if (SDL_Init(0) < 0) { std::cerr << "ERROR: SDL could not initialize! SDL_Error: " << SDL_GetError() << std::endl; return 1; }
+    IMG_Init(IMG_INIT_PNG);
+
+    std::vector<AlphaPlane> planes;
+    bool ok = true;
+    for (const MaskedSprite& sprite : MASKED_SPRITES) {
+        std::string path = std::string(argv[1]) + "/" + sprite.path;
+        SDL_Surface* surface = loadDrawnSurface(path, sprite.w, sprite.h);
+        if (!surface) { ok = false; continue; }
+        if (surface->w != sprite.w || surface->h != sprite.h) { // The game has no mask for it either (sprites.cpp)
+            std::cerr << "ERROR: " << path << " is " << surface->w << "x" << surface->h << ", not its drawn " << sprite.w << "x" << sprite.h << "!" << std::endl;
+            SDL_FreeSurface(surface);
+            ok = false;
+            continue;
+        }
+        AlphaPlane plane;
+        plane.name = sprite.name;
+        if (!readAlphaPlane(surface, plane)) { std::cerr << "ERROR: Unable to lock " << path << "! SDL Error: " << SDL_GetError() << std::endl; ok = false; }
+        else {
+            CollisionMask mask;
+            buildCollisionMask(mask, plane.alpha.data(), plane.w, plane.h, plane.w, 1, COLLISION_ALPHA_THRESHOLD);
+            std::printf("  %-16s %3dx%-3d opaque bounds %d,%d - %d,%d\n", sprite.name, plane.w, plane.h, mask.left, mask.top, mask.right, mask.bottom);
+            planes.push_back(std::move(plane));
+        }
+        SDL_FreeSurface(surface);
+    }
+    IMG_Quit();
+    SDL_Quit();
+    if (!ok) { std::cerr << "ERROR: Not every sprite could be read, " << argv[2] << " was not written." << std::endl; return 1; }
+
+    std::ofstream out(argv[2], std::ios::binary | std::ios::trunc);
+    if (!out || !writeAlphaPlanes(out, planes)) { std::cerr << "ERROR: Unable to write " << argv[2] << "!" << std::endl; return 1; }
+    std::printf("Wrote %d alpha planes to %s.\n", (int)planes.size(), argv[2]);
+    return 0;
+}
@@ -0,0 +1,34 @@
+// Track Validator
+// Parses a track file (format in src/track.h) and checks that every segment, and
+// every pair of segments back to back, leaves a way through from any player height.
+// The check replays the road at the fixed tick rate with the player's real speed,
+// so run it on every track change; the game itself does not validate at load.
+//
+// Build (Windows): the "Build Track Validator" task in .vscode/tasks.json, then "Validate Tracks".
+// Build (Linux):   g++ -O2 -std=c++17 tools/track_validator.cpp src/track.cpp src/entities.cpp src/collision_mask.cpp -Isrc -o bin/track_validator
+// Usage:           track_validator <file.track>...
+
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+
+#include "track.h"
+
+int main(int argc, char* argv[]) {
+    if (argc < 2) { std::cerr << "Usage: " << argv[0] << " <file.track>..." << std::endl; return 1; }
+    int failures = 0;
+    for (int i = 1; i < argc; ++i) {
+        std::ifstream in(argv[i], std::ios::binary);
+        if (!in) { std::cerr << "ERROR: Cannot open " << argv[i] << std::endl; failures++; continue; }
+        std::stringstream text;
+        text << in.rdbuf();
+
+        Track track;
+        if (!parseTrack(text.str(), argv[i], track)) { failures++; continue; }
+        std::cout << argv[i] << ": '" << track.name << "', " << track.segments.size() << " segments" << std::endl;
+        if (validateTrack(track, std::cout)) std::cout << "  OK" << std::endl;
+        else failures++;
+    }
+    return failures == 0 ? 0 : 1;
+}